@@ -0,0 +1,74 @@
+// Headless front end for the synthetic graph generators: times generation and the CSR build for
+// every model at a chosen size, and checks that a second run with the same seed is identical.
+//
+//   graph_gen_bench [scale=20] [edgeFactor=16] [seed=1]
+//
+// R-MAT and Barabási-Albert use 2^scale vertices with edgeFactor edges each; Erdős–Rényi and the
+// random geometric graph are sized to roughly the same edge count; the grid is a square torus.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "../src/algo/GraphGenerators.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+static void measure(const char* label, const GraphGenerators::Spec& spec) {
+    auto t0 = Clock::now();
+    GraphGenerators::EdgeBuffer b = GraphGenerators::generate(spec);
+    double genMs = msSince(t0);
+    t0 = Clock::now();
+    CSRGraph csr = b.toCSR();
+    double csrMs = msSince(t0);
+
+    int maxDegree = 0;
+    for (int u = 0; u < csr.vertexCount(); ++u) maxDegree = std::max(maxDegree, csr.degree(u));
+    GraphGenerators::EdgeBuffer again = GraphGenerators::generate(spec);
+    bool same = again.src == b.src && again.dst == b.dst;
+
+    std::printf("%-18s %10d %12lld %10.1f %12.1f %9.1f %10d %6s\n", label, b.n, b.edgeCount(), genMs,
+                b.edgeCount() / std::max(genMs, 1e-3) / 1000.0, csrMs, maxDegree, same ? "yes" : "NO");
+}
+
+int main(int argc, char** argv) {
+    int scale = argc > 1 ? std::atoi(argv[1]) : 20;
+    int edgeFactor = argc > 2 ? std::atoi(argv[2]) : 16;
+    long long seed = argc > 3 ? std::atoll(argv[3]) : 1;
+    if (scale < 1 || scale > 26 || edgeFactor < 1) {
+        std::fprintf(stderr, "usage: %s [scale 1-26] [edgeFactor>=1] [seed]\n", argv[0]);
+        return 1;
+    }
+
+    int n = 1 << scale;
+    double m = (double)n * edgeFactor;
+    std::printf("%d vertices, ~%.0f edges per model, %d worker thread(s)\n\n", n, m, Parallel::threadCount());
+    std::printf("%-18s %10s %12s %10s %12s %9s %10s %6s\n", "model", "vertices", "edges", "gen ms",
+                "Medges/s", "CSR ms", "max deg", "repro");
+
+    GraphGenerators::Spec spec;
+    spec.seed = (uint64_t)seed;
+    spec.scale = scale;
+    spec.edgeFactor = edgeFactor;
+    spec.vertices = n;
+
+    spec.model = GraphGenerators::Model::RMAT;
+    measure("R-MAT", spec);
+    spec.model = GraphGenerators::Model::ErdosRenyi;
+    spec.probability = 2.0 * m / ((double)n * (n - 1));
+    measure("Erdos-Renyi", spec);
+    spec.model = GraphGenerators::Model::BarabasiAlbert;
+    measure("Barabasi-Albert", spec);
+    spec.model = GraphGenerators::Model::Grid;
+    spec.rows = spec.cols = (int)std::sqrt((double)n);
+    spec.wrap = true;
+    measure("Grid (torus)", spec);
+    spec.model = GraphGenerators::Model::RandomGeometric;
+    spec.radius = std::sqrt(2.0 * m / ((double)n * (n - 1) * M_PI));
+    measure("Random geometric", spec);
+    return 0;
+}
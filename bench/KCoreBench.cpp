@@ -0,0 +1,80 @@
+// Sequential against parallel core decomposition: times Batagelj–Zaversnik and the
+// level-synchronous parallel peel on each generator model and checks the core numbers agree.
+// The onion layout only runs the sequential one; this is where the two are compared.
+//
+//   k_core_bench [scale=20] [edgeFactor=16] [repeats=3]
+//
+// Graphs are sized as in graph_gen_bench: 2^scale vertices and about edgeFactor edges each.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "../src/algo/GraphGenerators.h"
+#include "../src/algo/KCore.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// Returns false when the two decompositions disagree
+static bool measure(const char* label, const GraphGenerators::Spec& spec, int repeats) {
+    CSRGraph sym = GraphGenerators::generate(spec).toCSR().symmetrize();
+    KCore::Result cores, peeled;
+    double bzMs = 0.0, peelMs = 0.0;
+    for (int r = 0; r < repeats; ++r) {
+        auto t0 = Clock::now();
+        cores = KCore::batageljZaversnik(sym);
+        bzMs += msSince(t0);
+        t0 = Clock::now();
+        peeled = KCore::parallelPeel(sym);
+        peelMs += msSince(t0);
+    }
+    bzMs /= repeats;
+    peelMs /= repeats;
+    bool same = cores.core == peeled.core && cores.maxCore == peeled.maxCore;
+
+    std::printf("%-18s %10d %12lld %6d %10.1f %12.1f %7.2fx %8d %6s\n", label, sym.vertexCount(), sym.arcCount() / 2,
+                cores.maxCore, bzMs, peelMs, bzMs / std::max(peelMs, 1e-3), peeled.rounds, same ? "yes" : "NO");
+    return same;
+}
+
+int main(int argc, char** argv) {
+    int scale = argc > 1 ? std::atoi(argv[1]) : 20;
+    int edgeFactor = argc > 2 ? std::atoi(argv[2]) : 16;
+    int repeats = argc > 3 ? std::atoi(argv[3]) : 3;
+    if (scale < 1 || scale > 26 || edgeFactor < 1 || repeats < 1) {
+        std::fprintf(stderr, "usage: %s [scale 1-26] [edgeFactor>=1] [repeats>=1]\n", argv[0]);
+        return 1;
+    }
+
+    int n = 1 << scale;
+    double m = (double)n * edgeFactor;
+    std::printf("%d vertices, ~%.0f edges per model, %d worker thread(s)\n\n", n, m, Parallel::threadCount());
+    std::printf("%-18s %10s %12s %6s %10s %12s %8s %8s %6s\n", "model", "vertices", "edges", "degen",
+                "BZ ms", "peel ms", "speedup", "rounds", "same");
+
+    GraphGenerators::Spec spec;
+    spec.scale = scale;
+    spec.edgeFactor = edgeFactor;
+    spec.vertices = n;
+    bool ok = true;
+
+    spec.model = GraphGenerators::Model::RMAT;
+    ok &= measure("R-MAT", spec, repeats);
+    spec.model = GraphGenerators::Model::ErdosRenyi;
+    spec.probability = 2.0 * m / ((double)n * (n - 1));
+    ok &= measure("Erdos-Renyi", spec, repeats);
+    spec.model = GraphGenerators::Model::BarabasiAlbert;
+    ok &= measure("Barabasi-Albert", spec, repeats);
+    spec.model = GraphGenerators::Model::Grid;
+    spec.rows = spec.cols = (int)std::sqrt((double)n);
+    spec.wrap = true;
+    ok &= measure("Grid (torus)", spec, repeats);
+    spec.model = GraphGenerators::Model::RandomGeometric;
+    spec.radius = std::sqrt(2.0 * m / ((double)n * (n - 1) * M_PI));
+    ok &= measure("Random geometric", spec, repeats);
+    return ok ? 0 : 1;
+}
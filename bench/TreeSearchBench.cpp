@@ -0,0 +1,86 @@
+// Lookup throughput of the arena BSTree against its frozen Eytzinger and van Emde Boas snapshots,
+// B+-trees with one cache line and one page of keys per node, and std::lower_bound over the
+// sorted keys for reference, for trees of 10^3 up to 10^maxExp keys. Keys are the even numbers
+// 0, 2, ..., so about half of the random queries hit.
+//
+//   tree_search_bench [maxExp=7] [queries=2000000]
+//
+// 10^8 keys needs roughly 6 GB: the arena tree alone is 28 bytes per node.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include "../src/ds/Tree.h"
+#include "../src/ds/FrozenTree.h"
+#include "../src/ds/BPlusTree.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// Runs every query through contains and reports ns per lookup; the hit count keeps the loop
+// from being optimised away and lets the rows be compared
+template <class F>
+static void measure(const char* label, const std::vector<int>& queries, F&& contains, double buildMs, size_t bytes) {
+    auto t0 = Clock::now();
+    long long hits = 0;
+    for (int q : queries) hits += contains(q);
+    double ms = msSince(t0);
+    std::printf("  %-16s %9.1f %10.1f %12.1f %12lld\n", label, buildMs, ms * 1e6 / queries.size(), bytes / 1048576.0, hits);
+}
+
+int main(int argc, char** argv) {
+    int maxExp = argc > 1 ? std::atoi(argv[1]) : 7;
+    int queryCount = argc > 2 ? std::atoi(argv[2]) : 2000000;
+    if (maxExp < 3 || maxExp > 8 || queryCount < 1) {
+        std::fprintf(stderr, "usage: %s [maxExp 3-8] [queries>=1]\n", argv[0]);
+        return 1;
+    }
+
+    std::mt19937 rng(7);
+    for (int e = 3; e <= maxExp; ++e) {
+        int n = 1;
+        for (int i = 0; i < e; ++i) n *= 10;
+        std::vector<int> keys(n);
+        for (int i = 0; i < n; ++i) keys[i] = 2 * i;
+        std::vector<int> queries(queryCount);
+        std::uniform_int_distribution<int> pick(0, 2 * n - 1);
+        for (int& q : queries) q = pick(rng);
+
+        std::printf("10^%d keys\n  %-16s %9s %10s %12s %12s\n", e, "layout", "build ms", "ns/lookup", "MiB", "hits");
+        auto t0 = Clock::now();
+        BSTree tree;
+        tree.buildSorted(keys);
+        measure("BSTree (arena)", queries, [&](int q) { return tree.contains(q); }, msSince(t0),
+                (size_t)n * sizeof(BSTree::Node));
+
+        t0 = Clock::now();
+        FrozenTree eytzinger = FrozenTree::freeze(tree, FrozenTree::Layout::Eytzinger);
+        measure("Eytzinger", queries, [&](int q) { return eytzinger.contains(q); }, msSince(t0), eytzinger.memoryBytes());
+        eytzinger = FrozenTree();
+
+        t0 = Clock::now();
+        FrozenTree veb = FrozenTree::freeze(tree, FrozenTree::Layout::VanEmdeBoas);
+        measure("van Emde Boas", queries, [&](int q) { return veb.contains(q); }, msSince(t0), veb.memoryBytes());
+        veb = FrozenTree();
+
+        for (int bytes : {64, 4096}) {
+            t0 = Clock::now();
+            BPlusTree bplus(BPlusTree::fanoutForBytes(bytes));
+            bplus.bulkLoad(keys);
+            measure(bytes == 64 ? "B+ tree (64 B)" : "B+ tree (4 KiB)", queries, [&](int q) { return bplus.contains(q); },
+                    msSince(t0), bplus.memoryBytes());
+        }
+
+        measure("sorted array", queries, [&](int q) {
+            auto it = std::lower_bound(keys.begin(), keys.end(), q);
+            return it != keys.end() && *it == q;
+        }, 0.0, keys.size() * sizeof(int));
+        std::printf("\n");
+    }
+    return 0;
+}
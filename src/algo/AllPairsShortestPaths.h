@@ -0,0 +1,220 @@
+#ifndef ALL_PAIRS_SHORTEST_PATHS_H
+#define ALL_PAIRS_SHORTEST_PATHS_H
+
+#include <vector>
+#include <queue>
+#include <limits>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include "../ds/UnifiedGraph.h"
+#include "Parallel.h"
+
+#if defined(__AVX2__) || defined(__SSE4_1__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// All-pairs shortest paths over UnifiedGraph.
+// Dense graphs use a cache-blocked Floyd-Warshall whose tiles are processed in parallel,
+// sparse graphs use Johnson's algorithm (Bellman-Ford reweighting + one Dijkstra per source).
+class AllPairsShortestPaths {
+public:
+    // Large enough to mean "unreachable", small enough that INF + INF does not overflow
+    static constexpr int INF = std::numeric_limits<int>::max() / 4;
+    // Tile edge in vertices; a 64x64 int tile is 16 KiB, three of them stay in L2
+    static constexpr int BLOCK = 64;
+
+    enum class Method { Auto, FloydWarshall, Johnson };
+
+    struct Result {
+        int n{0};
+        std::vector<int> dist;   // row-major n x n
+        bool negativeCycle{false};
+        Method used{Method::Auto};
+
+        int at(int u, int v) const { return dist[(size_t)u * n + v]; }
+        bool reachable(int u, int v) const { return at(u, v) < INF / 2; }
+    };
+
+    static Result compute(const UnifiedGraph& g, Method method = Method::Auto) {
+        if (method == Method::Auto) method = preferJohnson(g) ? Method::Johnson : Method::FloydWarshall;
+        return method == Method::Johnson ? johnson(g) : floydWarshall(g);
+    }
+
+    // Johnson wins when E log V is well below V^2; the blocked FW kernel has much better
+    // constants, so the crossover is biased towards it.
+    static bool preferJohnson(const UnifiedGraph& g) {
+        double n = g.vertexCount();
+        if (n < 2 * BLOCK) return false;
+        double m = (double)g.arcCount();
+        return m * std::log2(n) * 4.0 < n * n;
+    }
+
+    static Result floydWarshall(const UnifiedGraph& g) {
+        Result r;
+        r.n = g.vertexCount();
+        r.used = Method::FloydWarshall;
+        int n = r.n;
+        if (n == 0) return r;
+
+        // Pad to a whole number of tiles; padded vertices are isolated and never improve a path
+        int blocks = (n + BLOCK - 1) / BLOCK;
+        int np = blocks * BLOCK;
+        std::vector<int> d((size_t)np * np, INF);
+        for (int i = 0; i < np; ++i) d[(size_t)i * np + i] = 0;
+        for (int u = 0; u < n; ++u) {
+            for (const auto& e : g.neighbors(u)) {
+                int& cell = d[(size_t)u * np + e.to];
+                cell = std::min(cell, g.effectiveWeight(e));
+            }
+        }
+
+        auto tile = [&](int bi, int bj) { return d.data() + (size_t)bi * BLOCK * np + (size_t)bj * BLOCK; };
+
+        for (int kb = 0; kb < blocks; ++kb) {
+            // Phase 1: the pivot tile depends only on itself
+            updateTile(tile(kb, kb), tile(kb, kb), tile(kb, kb), np);
+
+            // Phase 2: pivot row and pivot column tiles depend on the pivot tile
+            Parallel::forRange(0, 2 * blocks, 1, [&](int lo, int hi, int) {
+                for (int t = lo; t < hi; ++t) {
+                    int b = t % blocks;
+                    if (b == kb) continue;
+                    if (t < blocks) updateTile(tile(kb, b), tile(kb, kb), tile(kb, b), np);
+                    else updateTile(tile(b, kb), tile(b, kb), tile(kb, kb), np);
+                }
+            });
+
+            // Phase 3: every remaining tile depends on its pivot row and column tiles only
+            Parallel::forRange(0, blocks * blocks, 1, [&](int lo, int hi, int) {
+                for (int t = lo; t < hi; ++t) {
+                    int bi = t / blocks, bj = t % blocks;
+                    if (bi == kb || bj == kb) continue;
+                    updateTile(tile(bi, bj), tile(bi, kb), tile(kb, bj), np);
+                }
+            });
+        }
+
+        r.dist.resize((size_t)n * n);
+        for (int i = 0; i < n; ++i) {
+            std::copy(d.begin() + (size_t)i * np, d.begin() + (size_t)i * np + n, r.dist.begin() + (size_t)i * n);
+            if (d[(size_t)i * np + i] < 0) r.negativeCycle = true;
+        }
+        return r;
+    }
+
+    static Result johnson(const UnifiedGraph& g) {
+        Result r;
+        r.n = g.vertexCount();
+        r.used = Method::Johnson;
+        int n = r.n;
+        if (n == 0) return r;
+
+        // Bellman-Ford from a virtual source connected to every vertex with weight 0
+        std::vector<long long> h(n, 0);
+        bool hasNegative = false;
+        for (int u = 0; u < n && !hasNegative; ++u)
+            for (const auto& e : g.neighbors(u))
+                if (g.effectiveWeight(e) < 0) { hasNegative = true; break; }
+        if (hasNegative) {
+            // n + 1 vertices need at most n rounds; a change in round n + 1 means a negative cycle
+            for (int round = 0; round <= n; ++round) {
+                bool changed = false;
+                for (int u = 0; u < n; ++u) {
+                    for (const auto& e : g.neighbors(u)) {
+                        long long cand = h[u] + g.effectiveWeight(e);
+                        if (cand < h[e.to]) { h[e.to] = cand; changed = true; }
+                    }
+                }
+                if (!changed) break;
+                if (round == n) {
+                    r.negativeCycle = true;
+                    return r;
+                }
+            }
+        }
+
+        r.dist.assign((size_t)n * n, INF);
+        int workers = Parallel::threadCount();
+        std::vector<std::vector<long long>> scratch(workers, std::vector<long long>(n));
+
+        Parallel::forRange(0, n, 8, [&](int lo, int hi, int worker) {
+            std::vector<long long>& dist = scratch[worker];
+            using Item = std::pair<long long, int>;
+            std::priority_queue<Item, std::vector<Item>, std::greater<Item>> pq;
+            for (int s = lo; s < hi; ++s) {
+                std::fill(dist.begin(), dist.end(), std::numeric_limits<long long>::max());
+                dist[s] = 0;
+                pq.emplace(0, s);
+                while (!pq.empty()) {
+                    auto [du, u] = pq.top();
+                    pq.pop();
+                    if (du != dist[u]) continue;
+                    for (const auto& e : g.neighbors(u)) {
+                        long long nd = du + g.effectiveWeight(e) + h[u] - h[e.to];
+                        if (nd < dist[e.to]) {
+                            dist[e.to] = nd;
+                            pq.emplace(nd, e.to);
+                        }
+                    }
+                }
+                int* row = r.dist.data() + (size_t)s * n;
+                for (int v = 0; v < n; ++v) {
+                    if (dist[v] == std::numeric_limits<long long>::max()) continue;
+                    long long real = dist[v] - h[s] + h[v];
+                    row[v] = (int)std::max<long long>(-INF, std::min<long long>(INF, real));
+                }
+            }
+        });
+        return r;
+    }
+
+private:
+    // c[i][j] = min(c[i][j], a[i][k] + b[k][j]) over one BLOCK x BLOCK tile, k outermost.
+    // c may alias a or b (phases 1 and 2); with k outermost that is exactly Floyd-Warshall order.
+    static void updateTile(int* c, const int* a, const int* b, int stride) {
+        for (int k = 0; k < BLOCK; ++k) {
+            const int* bk = b + (size_t)k * stride;
+            for (int i = 0; i < BLOCK; ++i) {
+                int aik = a[(size_t)i * stride + k];
+                if (aik >= INF) continue;
+                minPlusRow(c + (size_t)i * stride, bk, aik);
+            }
+        }
+    }
+
+    static void minPlusRow(int* c, const int* b, int aik) {
+#if defined(__AVX2__)
+        __m256i va = _mm256_set1_epi32(aik);
+        for (int j = 0; j < BLOCK; j += 8) {
+            __m256i vb = _mm256_loadu_si256((const __m256i*)(b + j));
+            __m256i vc = _mm256_loadu_si256((const __m256i*)(c + j));
+            _mm256_storeu_si256((__m256i*)(c + j), _mm256_min_epi32(vc, _mm256_add_epi32(va, vb)));
+        }
+#elif defined(__SSE4_1__)
+        __m128i va = _mm_set1_epi32(aik);
+        for (int j = 0; j < BLOCK; j += 4) {
+            __m128i vb = _mm_loadu_si128((const __m128i*)(b + j));
+            __m128i vc = _mm_loadu_si128((const __m128i*)(c + j));
+            _mm_storeu_si128((__m128i*)(c + j), _mm_min_epi32(vc, _mm_add_epi32(va, vb)));
+        }
+#elif defined(__SSE2__)
+        // SSE2 has no signed 32-bit min, so select through a compare mask (x86-64 baseline)
+        __m128i va = _mm_set1_epi32(aik);
+        for (int j = 0; j < BLOCK; j += 4) {
+            __m128i vc = _mm_loadu_si128((const __m128i*)(c + j));
+            __m128i cand = _mm_add_epi32(va, _mm_loadu_si128((const __m128i*)(b + j)));
+            __m128i lt = _mm_cmplt_epi32(cand, vc);
+            _mm_storeu_si128((__m128i*)(c + j), _mm_or_si128(_mm_and_si128(lt, cand), _mm_andnot_si128(lt, vc)));
+        }
+#else
+        // Branch-free form so the compiler can vectorize it on its own
+        for (int j = 0; j < BLOCK; ++j) {
+            int cand = aik + b[j];
+            c[j] = cand < c[j] ? cand : c[j];
+        }
+#endif
+    }
+};
+
+#endif // ALL_PAIRS_SHORTEST_PATHS_H
@@ -0,0 +1,160 @@
+#ifndef BIPARTITE_MATCHING_H
+#define BIPARTITE_MATCHING_H
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "../ds/UnifiedGraph.h"
+#include "../ds/CSRGraph.h"
+
+// Bipartiteness test and maximum-cardinality matching over the undirected view of a graph
+// (direction and weights are ignored). Side 0 plays the role of tasks, side 1 of workers.
+class BipartiteMatching {
+public:
+    struct Sides {
+        bool bipartite{true};
+        std::vector<int> side;      // 0 or 1 per vertex; isolated vertices go to side 0
+        std::vector<int> oddCycle;  // when not bipartite: a closed odd walk v0 .. vk (vk == v0)
+    };
+
+    struct Result {
+        Sides sides;
+        std::vector<int> mate;      // matched partner, or -1
+        int size{0};
+        int phases{0};              // Hopcroft–Karp BFS phases, O(sqrt V)
+        // Augmenting paths in the order applied (free left, right, left, ..., free right);
+        // only kept when requested, for animation
+        std::vector<std::vector<int>> paths;
+    };
+
+    static Result compute(const UnifiedGraph& g, bool recordPaths = false) {
+        CSRGraph sym = CSRGraph::freeze(g).symmetrize();
+        Result r;
+        r.sides = twoColor(sym);
+        if (r.sides.bipartite) hopcroftKarp(sym, r, recordPaths);
+        else r.mate.assign(sym.vertexCount(), -1);
+        return r;
+    }
+
+    // BFS 2-colouring per component. On the first edge joining two vertices of the same colour,
+    // the two BFS tree paths up to their common ancestor close an odd cycle.
+    static Sides twoColor(const CSRGraph& sym) {
+        Sides s;
+        int n = sym.vertexCount();
+        s.side.assign(n, -1);
+        std::vector<int> parent(n, -1), depth(n, 0), queue;
+        queue.reserve(n);
+        for (int root = 0; root < n; ++root) {
+            if (s.side[root] >= 0) continue;
+            s.side[root] = 0;
+            queue.clear();
+            queue.push_back(root);
+            for (size_t head = 0; head < queue.size(); ++head) {
+                int u = queue[head];
+                for (const int* it = sym.neighborsBegin(u); it != sym.neighborsEnd(u); ++it) {
+                    int v = *it;
+                    if (s.side[v] < 0) {
+                        s.side[v] = 1 - s.side[u];
+                        parent[v] = u;
+                        depth[v] = depth[u] + 1;
+                        queue.push_back(v);
+                    } else if (s.side[v] == s.side[u]) {
+                        s.bipartite = false;
+                        // Walk both ends up to the common ancestor: u .. lca .. v, then back to u
+                        std::vector<int> up, down;
+                        int a = u, b = v;
+                        while (depth[a] > depth[b]) { up.push_back(a); a = parent[a]; }
+                        while (depth[b] > depth[a]) { down.push_back(b); b = parent[b]; }
+                        while (a != b) { up.push_back(a); a = parent[a]; down.push_back(b); b = parent[b]; }
+                        s.oddCycle = up;
+                        s.oddCycle.push_back(a);
+                        s.oddCycle.insert(s.oddCycle.end(), down.rbegin(), down.rend());
+                        s.oddCycle.push_back(u);
+                        return s;
+                    }
+                }
+            }
+        }
+        return s;
+    }
+
+    // Hopcroft–Karp: each phase finds, by one BFS from all free left vertices, the length of the
+    // shortest augmenting paths, then a DFS over that layered graph applies a maximal set of
+    // vertex-disjoint ones. O(E sqrt V) overall. The DFS is iterative so long paths cannot
+    // overflow the call stack.
+    static void hopcroftKarp(const CSRGraph& sym, Result& r, bool recordPaths) {
+        int n = sym.vertexCount();
+        const std::vector<int>& side = r.sides.side;
+        r.mate.assign(n, -1);
+        const int INF = std::numeric_limits<int>::max();
+        std::vector<int> dist(n), queue, stack, via(n, -1);
+        std::vector<long long> next(n);
+        queue.reserve(n);
+
+        // Greedy warm start: most of the matching comes cheaply from free-free edges
+        for (int u = 0; u < n; ++u) {
+            if (side[u] != 0 || r.mate[u] >= 0) continue;
+            for (const int* it = sym.neighborsBegin(u); it != sym.neighborsEnd(u); ++it)
+                if (r.mate[*it] < 0) {
+                    r.mate[u] = *it;
+                    r.mate[*it] = u;
+                    ++r.size;
+                    if (recordPaths) r.paths.push_back({u, *it});
+                    break;
+                }
+        }
+
+        for (;;) {
+            // BFS over left vertices; dist of a free right vertex's layer is `limit`
+            queue.clear();
+            for (int u = 0; u < n; ++u) {
+                if (side[u] == 0 && r.mate[u] < 0) { dist[u] = 0; queue.push_back(u); }
+                else dist[u] = INF;
+            }
+            int limit = INF;
+            for (size_t head = 0; head < queue.size(); ++head) {
+                int u = queue[head];
+                if (dist[u] >= limit) continue;
+                for (const int* it = sym.neighborsBegin(u); it != sym.neighborsEnd(u); ++it) {
+                    int w = r.mate[*it];
+                    if (w < 0) limit = std::min(limit, dist[u] + 1);
+                    else if (dist[w] == INF) { dist[w] = dist[u] + 1; queue.push_back(w); }
+                }
+            }
+            if (limit == INF) break;
+            ++r.phases;
+
+            for (int u = 0; u < n; ++u) next[u] = sym.offsets[u];
+            for (int root = 0; root < n; ++root) {
+                if (side[root] != 0 || r.mate[root] >= 0) continue;
+                stack.assign(1, root);
+                bool found = false;
+                while (!stack.empty() && !found) {
+                    int u = stack.back();
+                    if (next[u] == sym.offsets[u + 1]) { dist[u] = INF; stack.pop_back(); continue; }
+                    int v = sym.targets[next[u]++];
+                    int w = r.mate[v];
+                    if (w < 0 ? dist[u] + 1 == limit : dist[w] == dist[u] + 1) {
+                        via[u] = v;
+                        if (w < 0) found = true;
+                        else stack.push_back(w);
+                    }
+                }
+                if (!found) continue;
+                if (recordPaths) {
+                    std::vector<int> path;
+                    for (int x : stack) { path.push_back(x); path.push_back(via[x]); }
+                    r.paths.push_back(std::move(path));
+                }
+                for (int x : stack) {
+                    r.mate[x] = via[x];
+                    r.mate[via[x]] = x;
+                }
+                for (int x : stack) dist[x] = INF; // vertex-disjoint within the phase
+                ++r.size;
+            }
+        }
+    }
+};
+
+#endif // BIPARTITE_MATCHING_H
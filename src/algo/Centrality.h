@@ -0,0 +1,198 @@
+#ifndef CENTRALITY_H
+#define CENTRALITY_H
+
+#include <vector>
+#include <queue>
+#include <cmath>
+#include <limits>
+#include <functional>
+#include <utility>
+#include "../ds/CSRGraph.h"
+#include "Parallel.h"
+
+// Node importance scores computed over a CSR snapshot.
+// Reductions go through one cache-line-padded accumulator per worker so threads never share a line.
+class Centrality {
+public:
+    // (in + out) degree for directed graphs, plain degree for undirected ones, divided by n - 1
+    static std::vector<double> degree(const CSRGraph& g) {
+        int n = g.vertexCount();
+        std::vector<double> score(n, 0.0);
+        if (n == 0) return score;
+        for (int u = 0; u < n; ++u) {
+            score[u] += g.degree(u);
+            if (g.isDirected())
+                for (const int* it = g.neighborsBegin(u); it != g.neighborsEnd(u); ++it) score[*it] += 1.0;
+        }
+        double norm = n > 1 ? 1.0 / (n - 1) : 1.0;
+        for (double& s : score) s *= norm;
+        return score;
+    }
+
+    // Power iteration on the Google matrix. Each step is a pull-style SpMV over in-neighbours,
+    // so every worker writes a disjoint slice of the output. Dangling mass is spread uniformly.
+    static std::vector<double> pageRank(const CSRGraph& g, double damping = 0.85, double tolerance = 1e-9,
+                                        int maxIterations = 100, int* iterationsRun = nullptr) {
+        int n = g.vertexCount();
+        std::vector<double> rank(n, n ? 1.0 / n : 0.0);
+        if (iterationsRun) *iterationsRun = 0;
+        if (n == 0) return rank;
+
+        CSRGraph transposed;
+        if (g.isDirected()) transposed = g.transpose();
+        const CSRGraph& in = g.isDirected() ? transposed : g;
+
+        std::vector<double> contrib(n), next(n);
+        std::vector<Accumulator> acc(Parallel::threadCount());
+        const int grain = 2048;
+
+        for (int it = 0; it < maxIterations; ++it) {
+            resetAccumulators(acc);
+            Parallel::forRange(0, n, grain, [&](int lo, int hi, int worker) {
+                double dangling = 0.0;
+                for (int u = lo; u < hi; ++u) {
+                    int deg = g.degree(u);
+                    if (deg == 0) { dangling += rank[u]; contrib[u] = 0.0; }
+                    else contrib[u] = rank[u] / deg;
+                }
+                acc[worker].value += dangling;
+            });
+            double base = (1.0 - damping) / n + damping * sumAccumulators(acc) / n;
+
+            resetAccumulators(acc);
+            Parallel::forRange(0, n, grain, [&](int lo, int hi, int worker) {
+                double diff = 0.0;
+                for (int v = lo; v < hi; ++v) {
+                    double sum = 0.0;
+                    for (const int* it2 = in.neighborsBegin(v); it2 != in.neighborsEnd(v); ++it2) sum += contrib[*it2];
+                    next[v] = base + damping * sum;
+                    diff += std::fabs(next[v] - rank[v]);
+                }
+                acc[worker].value += diff;
+            });
+            rank.swap(next);
+            if (iterationsRun) *iterationsRun = it + 1;
+            if (sumAccumulators(acc) < tolerance) break;
+        }
+        return rank;
+    }
+
+    // Brandes' algorithm: one shortest-path DAG per source, sources split across workers,
+    // each worker adds dependencies into its own score vector and the vectors are summed at the end.
+    // Weighted graphs use Dijkstra; non-positive weights are treated as 1 so path counts stay finite.
+    static std::vector<double> betweenness(const CSRGraph& g) {
+        int n = g.vertexCount();
+        std::vector<double> score(n, 0.0);
+        if (n == 0) return score;
+
+        int workers = Parallel::threadCount();
+        std::vector<std::vector<double>> partial(workers);
+
+        Parallel::forRange(0, n, 16, [&](int lo, int hi, int worker) {
+            std::vector<double>& local = partial[worker];
+            if (local.empty()) local.assign(n, 0.0);
+            BrandesScratch s(n);
+            for (int src = lo; src < hi; ++src) {
+                if (g.isWeighted()) shortestPathDagWeighted(g, src, s);
+                else shortestPathDagUnweighted(g, src, s);
+                accumulateDependencies(g, src, s, local);
+            }
+        });
+
+        for (const auto& local : partial)
+            if (!local.empty())
+                for (int v = 0; v < n; ++v) score[v] += local[v];
+        if (!g.isDirected())
+            for (double& s : score) s *= 0.5;
+        return score;
+    }
+
+private:
+    struct alignas(64) Accumulator {
+        double value{0.0};
+    };
+
+    static void resetAccumulators(std::vector<Accumulator>& acc) {
+        for (auto& a : acc) a.value = 0.0;
+    }
+
+    static double sumAccumulators(const std::vector<Accumulator>& acc) {
+        double total = 0.0;
+        for (const auto& a : acc) total += a.value;
+        return total;
+    }
+
+    struct BrandesScratch {
+        std::vector<long long> dist;
+        std::vector<double> sigma, delta;
+        std::vector<int> order; // vertices in non-decreasing distance
+        explicit BrandesScratch(int n) : dist(n), sigma(n), delta(n) { order.reserve(n); }
+    };
+
+    static int pathWeight(const CSRGraph& g, long long k) {
+        return g.isWeighted() ? std::max(1, g.weights[k]) : 1;
+    }
+
+    static void resetScratch(int src, BrandesScratch& s) {
+        std::fill(s.dist.begin(), s.dist.end(), -1);
+        std::fill(s.sigma.begin(), s.sigma.end(), 0.0);
+        std::fill(s.delta.begin(), s.delta.end(), 0.0);
+        s.order.clear();
+        s.dist[src] = 0;
+        s.sigma[src] = 1.0;
+    }
+
+    static void shortestPathDagUnweighted(const CSRGraph& g, int src, BrandesScratch& s) {
+        resetScratch(src, s);
+        s.order.push_back(src);
+        for (size_t head = 0; head < s.order.size(); ++head) {
+            int u = s.order[head];
+            for (const int* it = g.neighborsBegin(u); it != g.neighborsEnd(u); ++it) {
+                int v = *it;
+                if (s.dist[v] < 0) { s.dist[v] = s.dist[u] + 1; s.order.push_back(v); }
+                if (s.dist[v] == s.dist[u] + 1) s.sigma[v] += s.sigma[u];
+            }
+        }
+    }
+
+    static void shortestPathDagWeighted(const CSRGraph& g, int src, BrandesScratch& s) {
+        resetScratch(src, s);
+        using Item = std::pair<long long, int>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> pq;
+        pq.emplace(0, src);
+        std::vector<char> settled(g.vertexCount(), 0);
+        while (!pq.empty()) {
+            auto [du, u] = pq.top();
+            pq.pop();
+            if (settled[u] || du != s.dist[u]) continue;
+            settled[u] = 1;
+            s.order.push_back(u);
+            for (long long k = g.offsets[u]; k < g.offsets[u + 1]; ++k) {
+                int v = g.targets[k];
+                long long nd = du + pathWeight(g, k);
+                if (s.dist[v] < 0 || nd < s.dist[v]) {
+                    s.dist[v] = nd;
+                    s.sigma[v] = s.sigma[u];
+                    pq.emplace(nd, v);
+                } else if (nd == s.dist[v]) {
+                    s.sigma[v] += s.sigma[u];
+                }
+            }
+        }
+    }
+
+    // Walk the DAG backwards; successors are found by re-scanning out-arcs that are tight
+    static void accumulateDependencies(const CSRGraph& g, int src, BrandesScratch& s, std::vector<double>& out) {
+        for (int i = (int)s.order.size() - 1; i >= 0; --i) {
+            int v = s.order[i];
+            for (long long k = g.offsets[v]; k < g.offsets[v + 1]; ++k) {
+                int w = g.targets[k];
+                if (s.dist[w] == s.dist[v] + pathWeight(g, k) && s.sigma[w] > 0)
+                    s.delta[v] += s.sigma[v] / s.sigma[w] * (1.0 + s.delta[w]);
+            }
+            if (v != src) out[v] += s.delta[v];
+        }
+    }
+};
+
+#endif // CENTRALITY_H
@@ -0,0 +1,314 @@
+#ifndef COMMUNITIES_H
+#define COMMUNITIES_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include "../ds/CSRGraph.h"
+#include "Parallel.h"
+
+// Community detection on the undirected view of a graph (CSRGraph::symmetrize()).
+// Weighted graphs use their edge weights as affinities (non-positive weights count as no tie),
+// unweighted graphs count every edge as 1. Results carry dense community IDs 0..count-1,
+// numbered in order of each community's lowest vertex ID, plus the partition's modularity.
+class Communities {
+public:
+    enum class Method { LabelPropagation, Louvain };
+
+    struct Result {
+        std::vector<int> community;
+        int count{0};
+        double modularity{0.0};
+        int rounds{0}; // propagation rounds, or Louvain levels
+    };
+
+    // Community graph for overview rendering: one node per community, one edge per linked pair
+    struct Summary {
+        int count{0};
+        std::vector<int> size;               // vertices per community
+        std::vector<double> internalWeight;  // edge weight inside each community
+        std::vector<int> src, dst;           // linked pairs, src < dst
+        std::vector<double> weight;          // total edge weight between the pair
+    };
+
+    static Result compute(const CSRGraph& g, Method method, uint64_t seed = 1) {
+        CSRGraph sym = g.symmetrize();
+        return method == Method::Louvain ? louvain(sym, 1.0, seed) : labelPropagation(sym, seed);
+    }
+
+    // Each vertex adopts the label carrying the most edge weight among its neighbours (ties keep
+    // the current label, otherwise go to a seeded hash). Updates are synchronous within a
+    // sub-round, so workers only read the previous labels and the result does not depend on the
+    // thread count. Every round re-deals the vertices over four sub-rounds by hash, so neighbours
+    // that would swap labels forever under plain synchronous updates soon land apart.
+    static Result labelPropagation(const CSRGraph& sym, uint64_t seed = 1, int maxRounds = 40) {
+        Result r;
+        int n = sym.vertexCount();
+        std::vector<int> label(n), next(n);
+        std::iota(label.begin(), label.end(), 0);
+        const int subRounds = 4;
+        std::vector<unsigned char> phase(n);
+
+        std::vector<std::vector<std::pair<int, double>>> scratch(Parallel::threadCount());
+        std::vector<Counter> moved(Parallel::threadCount());
+        const int grain = 1024;
+        for (int round = 0; round < maxRounds; ++round) {
+            for (Counter& c : moved) c.value = 0;
+            for (int v = 0; v < n; ++v) phase[v] = (unsigned char)(mix(seed + (uint64_t)round, (uint64_t)v) % subRounds);
+            for (int ph = 0; ph < subRounds; ++ph) {
+                Parallel::forRange(0, n, grain, [&](int lo, int hi, int worker) {
+                    std::vector<std::pair<int, double>>& row = scratch[worker];
+                    for (int v = lo; v < hi; ++v) {
+                        next[v] = label[v];
+                        if (phase[v] != ph) continue;
+                        row.clear();
+                        for (long long k = sym.offsets[v]; k < sym.offsets[v + 1]; ++k) {
+                            double w = affinity(sym, k);
+                            if (w > 0) row.emplace_back(label[sym.targets[k]], w);
+                        }
+                        if (row.empty()) continue;
+                        std::sort(row.begin(), row.end());
+                        int best = label[v];
+                        double bestWeight = 0.0, ownWeight = 0.0;
+                        uint64_t bestKey = ~0ull;
+                        for (size_t i = 0; i < row.size();) {
+                            int l = row[i].first;
+                            double sum = 0.0;
+                            for (; i < row.size() && row[i].first == l; ++i) sum += row[i].second;
+                            if (l == label[v]) ownWeight = sum;
+                            uint64_t key = mix(seed ^ (uint64_t)round, (uint64_t)l);
+                            if (sum > bestWeight || (sum == bestWeight && key < bestKey)) {
+                                best = l;
+                                bestWeight = sum;
+                                bestKey = key;
+                            }
+                        }
+                        if (ownWeight >= bestWeight) best = label[v];
+                        if (best != label[v]) {
+                            next[v] = best;
+                            ++moved[worker].value;
+                        }
+                    }
+                });
+                label.swap(next);
+            }
+            r.rounds = round + 1;
+            long long total = 0;
+            for (const Counter& c : moved) total += c.value;
+            if (total == 0) break;
+        }
+        r.count = densify(label);
+        r.community = std::move(label);
+        r.modularity = modularity(sym, r.community);
+        return r;
+    }
+
+    // Blondel et al.: move single vertices to the neighbouring community with the best modularity
+    // gain until nothing improves, collapse every community into one vertex, repeat on the smaller
+    // graph. Vertices are visited in a seeded random order.
+    static Result louvain(const CSRGraph& sym, double resolution = 1.0, uint64_t seed = 1, int maxLevels = 20) {
+        Result r;
+        int n = sym.vertexCount();
+        Level level;
+        level.n = n;
+        level.offsets = sym.offsets;
+        level.targets = sym.targets;
+        level.weights.resize(sym.targets.size());
+        for (size_t k = 0; k < sym.targets.size(); ++k) level.weights[k] = affinity(sym, (long long)k);
+        level.loop.assign(n, 0.0);
+
+        std::vector<int> assign(n);
+        std::iota(assign.begin(), assign.end(), 0);
+        std::vector<int> comm;
+        for (int depth = 0; depth < maxLevels && level.n > 0; ++depth) {
+            if (!moveVertices(level, comm, resolution, seed + (uint64_t)depth)) break;
+            int count = densify(comm);
+            for (int v = 0; v < n; ++v) assign[v] = comm[assign[v]];
+            r.rounds = depth + 1;
+            if (count == level.n) break;
+            level = aggregate(level, comm, count);
+        }
+        r.count = densify(assign);
+        r.community = std::move(assign);
+        r.modularity = modularity(sym, r.community, resolution);
+        return r;
+    }
+
+    // Newman's Q = sum over communities of in_c / 2m - resolution * (tot_c / 2m)^2
+    static double modularity(const CSRGraph& sym, const std::vector<int>& community, double resolution = 1.0) {
+        int n = sym.vertexCount();
+        int count = 0;
+        for (int c : community) count = std::max(count, c + 1);
+        std::vector<double> in(count, 0.0), tot(count, 0.0);
+        double m2 = 0.0;
+        for (int u = 0; u < n; ++u) {
+            for (long long k = sym.offsets[u]; k < sym.offsets[u + 1]; ++k) {
+                double w = affinity(sym, k);
+                tot[community[u]] += w;
+                if (community[sym.targets[k]] == community[u]) in[community[u]] += w;
+                m2 += w;
+            }
+        }
+        if (m2 <= 0.0) return 0.0;
+        double q = 0.0;
+        for (int c = 0; c < count; ++c) q += in[c] / m2 - resolution * (tot[c] / m2) * (tot[c] / m2);
+        return q;
+    }
+
+    static Summary summarize(const CSRGraph& sym, const Result& r) {
+        Summary s;
+        s.count = r.count;
+        s.size.assign(r.count, 0);
+        s.internalWeight.assign(r.count, 0.0);
+        for (int c : r.community) ++s.size[c];
+        std::vector<std::pair<uint64_t, double>> links;
+        for (int u = 0; u < sym.vertexCount(); ++u) {
+            for (long long k = sym.offsets[u]; k < sym.offsets[u + 1]; ++k) {
+                int v = sym.targets[k];
+                if (v < u) continue; // each edge once
+                int cu = r.community[u], cv = r.community[v];
+                double w = affinity(sym, k);
+                if (cu == cv) s.internalWeight[cu] += w;
+                else links.emplace_back(((uint64_t)std::min(cu, cv) << 32) | (uint32_t)std::max(cu, cv), w);
+            }
+        }
+        std::sort(links.begin(), links.end());
+        for (size_t i = 0; i < links.size();) {
+            uint64_t key = links[i].first;
+            double sum = 0.0;
+            for (; i < links.size() && links[i].first == key; ++i) sum += links[i].second;
+            s.src.push_back((int)(key >> 32));
+            s.dst.push_back((int)(key & 0xffffffffu));
+            s.weight.push_back(sum);
+        }
+        return s;
+    }
+
+private:
+    struct alignas(64) Counter {
+        long long value{0};
+    };
+
+    // Weighted adjacency of one Louvain level; loop[u] is the weight folded into u itself
+    struct Level {
+        int n{0};
+        std::vector<long long> offsets;
+        std::vector<int> targets;
+        std::vector<double> weights;
+        std::vector<double> loop;
+    };
+
+    static double affinity(const CSRGraph& g, long long k) {
+        return g.isWeighted() ? std::max(0, g.weights[k]) : 1.0;
+    }
+
+    static uint64_t mix(uint64_t seed, uint64_t x) {
+        uint64_t z = seed + 0x9e3779b97f4a7c15ull * (x + 1);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    // Renumbers labels to 0..count-1 in order of first appearance; returns count
+    static int densify(std::vector<int>& label) {
+        int maxLabel = -1;
+        for (int l : label) maxLabel = std::max(maxLabel, l);
+        std::vector<int> id(maxLabel + 1, -1);
+        int count = 0;
+        for (int& l : label) {
+            if (id[l] < 0) id[l] = count++;
+            l = id[l];
+        }
+        return count;
+    }
+
+    // One Louvain phase; returns false if no vertex moved
+    static bool moveVertices(const Level& g, std::vector<int>& comm, double resolution, uint64_t seed) {
+        int n = g.n;
+        comm.resize(n);
+        std::iota(comm.begin(), comm.end(), 0);
+        std::vector<double> k(n, 0.0), tot(n);
+        double m2 = 0.0;
+        for (int u = 0; u < n; ++u) {
+            k[u] = 2.0 * g.loop[u];
+            for (long long e = g.offsets[u]; e < g.offsets[u + 1]; ++e) k[u] += g.weights[e];
+            tot[u] = k[u];
+            m2 += k[u];
+        }
+        if (m2 <= 0.0) return false;
+
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        for (int i = n - 1; i > 0; --i) std::swap(order[i], order[mix(seed, (uint64_t)i) % (uint64_t)(i + 1)]);
+
+        std::vector<double> linkWeight(n, -1.0);
+        std::vector<int> touched;
+        bool anyMoved = false;
+        for (int pass = 0; pass < 100; ++pass) {
+            long long moves = 0;
+            for (int u : order) {
+                int own = comm[u];
+                for (long long e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                    int c = comm[g.targets[e]];
+                    if (linkWeight[c] < 0) { linkWeight[c] = 0.0; touched.push_back(c); }
+                    linkWeight[c] += g.weights[e];
+                }
+                tot[own] -= k[u];
+                double scale = resolution * k[u] / m2;
+                int best = own;
+                double bestGain = std::max(0.0, linkWeight[own]) - scale * tot[own];
+                for (int c : touched) {
+                    double gain = linkWeight[c] - scale * tot[c];
+                    if (gain > bestGain + 1e-12) { best = c; bestGain = gain; }
+                }
+                tot[best] += k[u];
+                if (best != own) { comm[u] = best; ++moves; }
+                for (int c : touched) linkWeight[c] = -1.0;
+                touched.clear();
+            }
+            if (moves == 0) break;
+            anyMoved = true;
+        }
+        return anyMoved;
+    }
+
+    // Collapses each community into one vertex; edges inside it become its loop weight
+    static Level aggregate(const Level& g, const std::vector<int>& comm, int count) {
+        Level next;
+        next.n = count;
+        next.offsets.assign(count + 1, 0);
+        next.loop.assign(count, 0.0);
+        std::vector<int> start(count + 1, 0), members(g.n);
+        for (int u = 0; u < g.n; ++u) ++start[comm[u] + 1];
+        for (int c = 0; c < count; ++c) start[c + 1] += start[c];
+        std::vector<int> fill(start.begin(), start.end() - 1);
+        for (int u = 0; u < g.n; ++u) members[fill[comm[u]]++] = u;
+
+        std::vector<double> linkWeight(count, -1.0);
+        std::vector<int> touched;
+        for (int c = 0; c < count; ++c) {
+            for (int i = start[c]; i < start[c + 1]; ++i) {
+                int u = members[i];
+                next.loop[c] += g.loop[u];
+                for (long long e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                    int cv = comm[g.targets[e]];
+                    if (cv == c) { next.loop[c] += g.weights[e] / 2; continue; } // seen from both ends
+                    if (linkWeight[cv] < 0) { linkWeight[cv] = 0.0; touched.push_back(cv); }
+                    linkWeight[cv] += g.weights[e];
+                }
+            }
+            for (int cv : touched) {
+                next.targets.push_back(cv);
+                next.weights.push_back(linkWeight[cv]);
+                linkWeight[cv] = -1.0;
+            }
+            touched.clear();
+            next.offsets[c + 1] = (long long)next.targets.size();
+        }
+        return next;
+    }
+};
+
+#endif // COMMUNITIES_H
@@ -0,0 +1,175 @@
+#ifndef GRAPH_COLORING_H
+#define GRAPH_COLORING_H
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include "../ds/CSRGraph.h"
+#include "Parallel.h"
+
+// Proper vertex colourings (adjacent vertices never share a colour) of the undirected view of a
+// graph. Colour classes are independent sets, so each class can be processed in parallel without
+// conflicts. Both methods are first-fit: a vertex takes the smallest colour its already-coloured
+// neighbours leave free.
+class GraphColoring {
+public:
+    enum class Method { SmallestLast, JonesPlassmann };
+
+    struct Result {
+        std::vector<int> color;
+        int colors{0};
+        int rounds{0};      // Jones–Plassmann: dependency rounds (1 for the sequential method)
+        int degeneracy{0};  // smallest-last only: max degree at removal; colors <= degeneracy + 1
+    };
+
+    static Result compute(const CSRGraph& g, Method method, uint64_t seed = 1) {
+        CSRGraph sym = g.symmetrize();
+        return method == Method::JonesPlassmann ? jonesPlassmann(sym, seed) : smallestLast(sym);
+    }
+
+    // Matula–Beck: repeatedly strip a minimum-degree vertex (bucket queue, O(V + E)), then colour
+    // in reverse removal order. Usually the fewest colours of the greedy orderings.
+    static Result smallestLast(const CSRGraph& sym) {
+        Result r;
+        int n = sym.vertexCount();
+        r.color.assign(n, -1);
+        r.rounds = n > 0 ? 1 : 0;
+        if (n == 0) return r;
+
+        int maxDegree = 0;
+        std::vector<int> degree(n);
+        for (int u = 0; u < n; ++u) maxDegree = std::max(maxDegree, degree[u] = sym.degree(u));
+        // Vertices sorted by degree with a position index, so moving one down a bucket is a swap
+        std::vector<int> bucketStart(maxDegree + 2, 0), order(n), position(n);
+        for (int u = 0; u < n; ++u) ++bucketStart[degree[u] + 1];
+        for (int d = 0; d <= maxDegree; ++d) bucketStart[d + 1] += bucketStart[d];
+        std::vector<int> fill(bucketStart.begin(), bucketStart.end() - 1);
+        for (int u = 0; u < n; ++u) {
+            position[u] = fill[degree[u]]++;
+            order[position[u]] = u;
+        }
+
+        std::vector<char> removed(n, 0);
+        for (int i = 0; i < n; ++i) {
+            int u = order[i];
+            removed[u] = 1;
+            r.degeneracy = std::max(r.degeneracy, degree[u]);
+            for (const int* it = sym.neighborsBegin(u); it != sym.neighborsEnd(u); ++it) {
+                int v = *it;
+                if (removed[v]) continue;
+                // Swap v to the front of its bucket, then shrink the bucket past it
+                int d = degree[v];
+                int front = std::max(bucketStart[d], i + 1);
+                int w = order[front];
+                std::swap(order[front], order[position[v]]);
+                std::swap(position[w], position[v]);
+                bucketStart[d] = front + 1;
+                --degree[v];
+            }
+        }
+
+        std::vector<int> stamp(maxDegree + 2, -1);
+        for (int i = n - 1; i >= 0; --i) {
+            int u = order[i];
+            for (const int* it = sym.neighborsBegin(u); it != sym.neighborsEnd(u); ++it)
+                if (r.color[*it] >= 0 && r.color[*it] <= maxDegree) stamp[r.color[*it]] = u;
+            int c = 0;
+            while (stamp[c] == u) ++c;
+            r.color[u] = c;
+            r.colors = std::max(r.colors, c + 1);
+        }
+        return r;
+    }
+
+    // Jones–Plassmann with largest-degree-first priorities (ties broken by a seeded hash). A
+    // vertex is coloured once every higher-priority neighbour is, so each round colours an
+    // independent set in parallel and then releases the vertices waiting on it. Colours depend
+    // only on the priorities, never on thread timing.
+    static Result jonesPlassmann(const CSRGraph& sym, uint64_t seed = 1) {
+        Result r;
+        int n = sym.vertexCount();
+        r.color.assign(n, -1);
+        if (n == 0) return r;
+
+        std::vector<uint64_t> priority(n);
+        int maxDegree = 0;
+        for (int u = 0; u < n; ++u) {
+            maxDegree = std::max(maxDegree, sym.degree(u));
+            // Degree in the high bits, hash below: largest degree first, random among equals
+            priority[u] = ((uint64_t)sym.degree(u) << 32) | (uint32_t)mix(seed, (uint64_t)u);
+        }
+        auto before = [&](int a, int b) { return priority[a] > priority[b] || (priority[a] == priority[b] && a > b); };
+
+        std::vector<std::atomic<int>> waiting(n);
+        std::vector<std::vector<int>> parts(Parallel::threadCount());
+        const int grain = 1024;
+        Parallel::forRange(0, n, grain, [&](int lo, int hi, int worker) {
+            for (int u = lo; u < hi; ++u) {
+                int count = 0;
+                for (const int* it = sym.neighborsBegin(u); it != sym.neighborsEnd(u); ++it) count += before(*it, u);
+                waiting[u].store(count, std::memory_order_relaxed);
+                if (count == 0) parts[worker].push_back(u);
+            }
+        });
+
+        std::vector<int> frontier;
+        std::vector<std::vector<int>> stamps(Parallel::threadCount(), std::vector<int>(maxDegree + 2, -1));
+        std::vector<Counter> used(Parallel::threadCount());
+        for (;;) {
+            frontier.clear();
+            for (auto& part : parts) {
+                frontier.insert(frontier.end(), part.begin(), part.end());
+                part.clear();
+            }
+            if (frontier.empty()) break;
+            ++r.rounds;
+            Parallel::forRange(0, (int)frontier.size(), 256, [&](int lo, int hi, int worker) {
+                std::vector<int>& stamp = stamps[worker];
+                for (int i = lo; i < hi; ++i) {
+                    int u = frontier[i];
+                    for (const int* it = sym.neighborsBegin(u); it != sym.neighborsEnd(u); ++it)
+                        if (before(*it, u)) stamp[r.color[*it]] = u;
+                    int c = 0;
+                    while (stamp[c] == u) ++c;
+                    r.color[u] = c;
+                    used[worker].value = std::max(used[worker].value, (long long)c + 1);
+                }
+            });
+            // Release lower-priority neighbours; the last one to finish hands the vertex on
+            Parallel::forRange(0, (int)frontier.size(), 256, [&](int lo, int hi, int worker) {
+                for (int i = lo; i < hi; ++i) {
+                    int u = frontier[i];
+                    for (const int* it = sym.neighborsBegin(u); it != sym.neighborsEnd(u); ++it)
+                        if (before(u, *it) && waiting[*it].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                            parts[worker].push_back(*it);
+                }
+            });
+        }
+        for (const Counter& c : used) r.colors = std::max(r.colors, (int)c.value);
+        return r;
+    }
+
+    static bool isProper(const CSRGraph& sym, const std::vector<int>& color) {
+        for (int u = 0; u < sym.vertexCount(); ++u) {
+            if (color[u] < 0) return false;
+            for (const int* it = sym.neighborsBegin(u); it != sym.neighborsEnd(u); ++it)
+                if (*it != u && color[*it] == color[u]) return false;
+        }
+        return true;
+    }
+
+private:
+    struct alignas(64) Counter {
+        long long value{0};
+    };
+
+    static uint64_t mix(uint64_t seed, uint64_t x) {
+        uint64_t z = seed + 0x9e3779b97f4a7c15ull * (x + 1);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+};
+
+#endif // GRAPH_COLORING_H
@@ -0,0 +1,346 @@
+#ifndef GRAPH_GENERATORS_H
+#define GRAPH_GENERATORS_H
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include "../ds/CSRGraph.h"
+#include "Parallel.h"
+
+// Seeded synthetic graph generators for load testing.
+// Every generator splits its work into fixed blocks, each with its own random stream derived from
+// (seed, block), so the output is identical for a given seed no matter how many threads run.
+// Results come back as a flat edge list (struct of arrays) that converts to CSR in one counting
+// sort; undirected edges are listed once.
+class GraphGenerators {
+public:
+    enum class Model { RMAT, ErdosRenyi, BarabasiAlbert, Grid, RandomGeometric };
+
+    struct EdgeBuffer {
+        int n{0};
+        bool directed{false};
+        bool weighted{false};
+        std::vector<int> src, dst, weight;
+        std::vector<float> x, y; // unit-square coordinates when the model has them (grid, geometric)
+
+        long long edgeCount() const { return (long long)src.size(); }
+        bool hasCoordinates() const { return (int)x.size() == n && n > 0; }
+        CSRGraph toCSR() const { return CSRGraph::fromEdges(n, directed, weighted, src, dst, weight); }
+    };
+
+    // Everything a generator call needs, so UIs can fill one struct and call generate()
+    struct Spec {
+        Model model{Model::RMAT};
+        uint64_t seed{1};
+        bool directed{false};
+        int maxWeight{0};           // > 0: uniform weights in [1, maxWeight]
+        int vertices{1000};         // Erdős–Rényi, Barabási–Albert, random geometric
+        int scale{10};              // R-MAT: 2^scale vertices
+        int edgeFactor{8};          // R-MAT edges per vertex, Barabási–Albert edges per new vertex
+        double probability{0.01};   // Erdős–Rényi G(n, p)
+        double radius{0.05};        // random geometric, in the unit square
+        int rows{32}, cols{32};     // grid
+        bool wrap{false};           // grid as a torus
+    };
+
+    static EdgeBuffer generate(const Spec& s) {
+        EdgeBuffer b;
+        switch (s.model) {
+            case Model::RMAT: b = rmat(s.scale, s.edgeFactor, s.seed, s.directed); break;
+            case Model::ErdosRenyi: b = erdosRenyi(s.vertices, s.probability, s.seed, s.directed); break;
+            case Model::BarabasiAlbert: b = barabasiAlbert(s.vertices, s.edgeFactor, s.seed, s.directed); break;
+            case Model::Grid: b = grid(s.rows, s.cols, s.wrap, s.directed); break;
+            case Model::RandomGeometric: b = randomGeometric(s.vertices, s.radius, s.seed, s.directed); break;
+        }
+        if (s.maxWeight > 0) assignWeights(b, s.maxWeight, s.seed);
+        return b;
+    }
+
+    // Expected output size of generate(s), computed without generating, so callers can refuse a
+    // request that would not fit before allocating any of it
+    struct Estimate {
+        double vertices{0};
+        double edges{0};
+    };
+
+    static Estimate estimate(const Spec& s) {
+        double n = 0, edges = 0;
+        switch (s.model) {
+            case Model::RMAT: n = std::ldexp(1.0, s.scale); edges = n * s.edgeFactor; break;
+            case Model::ErdosRenyi: n = s.vertices; edges = s.probability * n * (n - 1) / (s.directed ? 1 : 2); break;
+            case Model::BarabasiAlbert: n = s.vertices; edges = n * s.edgeFactor; break;
+            case Model::Grid: n = (double)s.rows * s.cols; edges = 2 * n; break;
+            case Model::RandomGeometric: n = s.vertices; edges = n * (n - 1) / 2 * M_PI * s.radius * s.radius; break;
+        }
+        return {n, edges};
+    }
+
+    // Recursive-matrix model (Chakrabarti et al.): each edge descends `scale` levels of the
+    // adjacency matrix, picking a quadrant with probabilities a, b, c, 1-a-b-c. Skewed degrees,
+    // community-like blocks; self-loops and repeats are kept as generated.
+    static EdgeBuffer rmat(int scale, int edgeFactor, uint64_t seed, bool directed = false,
+                           double a = 0.57, double b = 0.19, double c = 0.19) {
+        EdgeBuffer out;
+        scale = std::clamp(scale, 1, 30);
+        out.n = 1 << scale;
+        out.directed = directed;
+        long long m = (long long)std::max(1, edgeFactor) * out.n;
+        out.src.resize(m);
+        out.dst.resize(m);
+        // Quadrant thresholds as 32-bit integers: one 64-bit draw covers two levels
+        const double unit = 4294967296.0;
+        uint32_t ta = (uint32_t)std::min(unit - 1, a * unit);
+        uint32_t tab = (uint32_t)std::min(unit - 1, (a + b) * unit);
+        uint32_t tabc = (uint32_t)std::min(unit - 1, (a + b + c) * unit);
+        int blocks = (int)((m + BLOCK - 1) / BLOCK);
+        Parallel::forRange(0, blocks, 1, [&](int lo, int hi, int) {
+            for (int blk = lo; blk < hi; ++blk) {
+                Rng rng(seed, 0x524d4154ull + blk);
+                long long end = std::min(m, (long long)(blk + 1) * BLOCK);
+                for (long long i = (long long)blk * BLOCK; i < end; ++i) {
+                    int u = 0, v = 0;
+                    uint64_t bits = 0;
+                    for (int level = 0; level < scale; ++level) {
+                        if ((level & 1) == 0) bits = rng.next();
+                        uint32_t r = (uint32_t)bits;
+                        bits >>= 32;
+                        int bitU = r >= tab;
+                        int bitV = (r >= ta && r < tab) | (r >= tabc);
+                        u = (u << 1) | bitU;
+                        v = (v << 1) | bitV;
+                    }
+                    out.src[i] = u;
+                    out.dst[i] = v;
+                }
+            }
+        });
+        return out;
+    }
+
+    // G(n, p) by geometric skipping (Batagelj–Brandes): O(n + m) instead of O(n^2) coin flips.
+    // Row u draws its own neighbours (all v != u when directed, v > u otherwise).
+    static EdgeBuffer erdosRenyi(int n, double p, uint64_t seed, bool directed = false) {
+        EdgeBuffer out;
+        out.n = std::max(0, n);
+        out.directed = directed;
+        if (out.n == 0 || p <= 0.0) return out;
+        p = std::min(p, 1.0);
+        double logQ = std::log(1.0 - p);
+        const int rowsPerBlock = 1024;
+        int blocks = (out.n + rowsPerBlock - 1) / rowsPerBlock;
+        std::vector<EdgeBuffer> parts(blocks);
+        Parallel::forRange(0, blocks, 1, [&](int lo, int hi, int) {
+            for (int blk = lo; blk < hi; ++blk) {
+                EdgeBuffer& part = parts[blk];
+                int rowEnd = std::min(out.n, (blk + 1) * rowsPerBlock);
+                for (int u = blk * rowsPerBlock; u < rowEnd; ++u) {
+                    Rng rng(seed, 0x45520000ull + u);
+                    long long first = directed ? 0 : u + 1;
+                    long long span = out.n - first - (directed ? 1 : 0); // candidates in this row
+                    for (long long k = -1;;) {
+                        double skip = p >= 1.0 ? 0.0 : std::floor(std::log(1.0 - rng.uniform()) / logQ);
+                        if ((double)k + 1.0 + skip >= (double)span) break;
+                        k += 1 + (long long)skip;
+                        long long v = first + k;
+                        if (directed && v >= u) ++v; // skip the diagonal
+                        part.src.push_back(u);
+                        part.dst.push_back((int)v);
+                    }
+                }
+            }
+        });
+        concat(parts, out);
+        return out;
+    }
+
+    // Preferential attachment with `d` edges per vertex, generated in parallel with the
+    // Sanders–Schulz scheme: edge i starts at i / d and copies a uniformly random earlier endpoint,
+    // which is a degree-proportional pick. Copying a target resolves recursively through that
+    // edge's own hash, so no edge depends on another thread's output. Self-loops are dropped.
+    static EdgeBuffer barabasiAlbert(int n, int d, uint64_t seed, bool directed = false) {
+        EdgeBuffer out;
+        out.n = std::max(0, n);
+        out.directed = directed;
+        d = std::max(1, d);
+        long long m = (long long)out.n * d;
+        std::vector<int> src(m), dst(m);
+        int blocks = (int)((m + BLOCK - 1) / BLOCK);
+        auto pick = [&](long long i) -> long long { // endpoint slot in [0, 2i)
+            return (long long)(mix(seed ^ 0x4241ull, (uint64_t)i) % (uint64_t)(2 * i));
+        };
+        Parallel::forRange(0, blocks, 1, [&](int lo, int hi, int) {
+            for (int blk = lo; blk < hi; ++blk) {
+                long long end = std::min(m, (long long)(blk + 1) * BLOCK);
+                for (long long i = (long long)blk * BLOCK; i < end; ++i) {
+                    long long slot = i == 0 ? 0 : pick(i);
+                    while (slot & 1) { // odd slot = target of edge slot / 2, resolve it
+                        long long j = slot >> 1;
+                        slot = j == 0 ? 0 : pick(j);
+                    }
+                    src[i] = (int)(i / d);
+                    dst[i] = (int)((slot >> 1) / d);
+                }
+            }
+        });
+        out.src.reserve(m);
+        out.dst.reserve(m);
+        for (long long i = 0; i < m; ++i) {
+            if (src[i] == dst[i]) continue;
+            out.src.push_back(src[i]);
+            out.dst.push_back(dst[i]);
+        }
+        return out;
+    }
+
+    // rows x cols lattice with right/down neighbours (wrapping around when `wrap`)
+    static EdgeBuffer grid(int rows, int cols, bool wrap = false, bool directed = false) {
+        EdgeBuffer out;
+        rows = std::max(1, rows);
+        cols = std::max(1, cols);
+        out.n = rows * cols;
+        out.directed = directed;
+        out.x.resize(out.n);
+        out.y.resize(out.n);
+        int right = wrap && cols > 2 ? cols : cols - 1;
+        int down = wrap && rows > 2 ? rows : rows - 1;
+        long long m = (long long)rows * right + (long long)down * cols;
+        out.src.resize(m);
+        out.dst.resize(m);
+        Parallel::forRange(0, rows, 64, [&](int lo, int hi, int) {
+            for (int r = lo; r < hi; ++r) {
+                long long k = (long long)r * right + (long long)std::min(r, down) * cols; // edges of earlier rows
+                for (int c = 0; c < cols; ++c) {
+                    int u = r * cols + c;
+                    out.x[u] = cols > 1 ? (float)c / (cols - 1) : 0.5f;
+                    out.y[u] = rows > 1 ? (float)r / (rows - 1) : 0.5f;
+                    if (c < right) { out.src[k] = u; out.dst[k] = r * cols + (c + 1) % cols; ++k; }
+                    if (r < down) { out.src[k] = u; out.dst[k] = ((r + 1) % rows) * cols + c; ++k; }
+                }
+            }
+        });
+        return out;
+    }
+
+    // n uniform points in the unit square, joined when closer than `radius`. Points are bucketed
+    // into a cell grid of side >= radius, so each point only inspects its 3x3 neighbourhood.
+    static EdgeBuffer randomGeometric(int n, double radius, uint64_t seed, bool directed = false) {
+        EdgeBuffer out;
+        out.n = std::max(0, n);
+        out.directed = directed;
+        out.x.resize(out.n);
+        out.y.resize(out.n);
+        if (out.n == 0) return out;
+        int pointBlocks = (out.n + (int)BLOCK - 1) / (int)BLOCK;
+        Parallel::forRange(0, pointBlocks, 1, [&](int lo, int hi, int) {
+            for (int blk = lo; blk < hi; ++blk) {
+                Rng rng(seed, 0x52474700ull + blk);
+                int end = std::min(out.n, (blk + 1) * (int)BLOCK);
+                for (int u = blk * (int)BLOCK; u < end; ++u) {
+                    out.x[u] = (float)rng.uniform();
+                    out.y[u] = (float)rng.uniform();
+                }
+            }
+        });
+
+        radius = std::max(radius, 1e-9);
+        int side = (int)std::min(1.0 / radius, std::sqrt((double)out.n) + 1);
+        side = std::max(1, side);
+        auto cellOf = [&](int u) {
+            int cx = std::min(side - 1, (int)(out.x[u] * side));
+            int cy = std::min(side - 1, (int)(out.y[u] * side));
+            return cy * side + cx;
+        };
+        std::vector<int> cellStart((size_t)side * side + 1, 0), members(out.n);
+        for (int u = 0; u < out.n; ++u) ++cellStart[cellOf(u) + 1];
+        for (size_t c = 0; c + 1 < cellStart.size(); ++c) cellStart[c + 1] += cellStart[c];
+        std::vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+        for (int u = 0; u < out.n; ++u) members[fill[cellOf(u)]++] = u;
+
+        double r2 = radius * radius;
+        const int pointsPerBlock = 4096;
+        int blocks = (out.n + pointsPerBlock - 1) / pointsPerBlock;
+        std::vector<EdgeBuffer> parts(blocks);
+        Parallel::forRange(0, blocks, 1, [&](int lo, int hi, int) {
+            for (int blk = lo; blk < hi; ++blk) {
+                EdgeBuffer& part = parts[blk];
+                int end = std::min(out.n, (blk + 1) * pointsPerBlock);
+                for (int u = blk * pointsPerBlock; u < end; ++u) {
+                    int cell = cellOf(u), cx = cell % side, cy = cell / side;
+                    for (int dy = -1; dy <= 1; ++dy) {
+                        for (int dx = -1; dx <= 1; ++dx) {
+                            int nx = cx + dx, ny = cy + dy;
+                            if (nx < 0 || ny < 0 || nx >= side || ny >= side) continue;
+                            int c = ny * side + nx;
+                            for (int k = cellStart[c]; k < cellStart[c + 1]; ++k) {
+                                int v = members[k];
+                                if (v <= u) continue;
+                                double ddx = out.x[u] - out.x[v], ddy = out.y[u] - out.y[v];
+                                if (ddx * ddx + ddy * ddy > r2) continue;
+                                part.src.push_back(u);
+                                part.dst.push_back(v);
+                            }
+                        }
+                    }
+                }
+            }
+        });
+        concat(parts, out);
+        return out;
+    }
+
+    // Uniform integer weights in [1, maxWeight], a pure function of (seed, edge position)
+    static void assignWeights(EdgeBuffer& b, int maxWeight, uint64_t seed) {
+        b.weighted = true;
+        long long m = b.edgeCount();
+        b.weight.resize(m);
+        int blocks = (int)((m + BLOCK - 1) / BLOCK);
+        Parallel::forRange(0, blocks, 1, [&](int lo, int hi, int) {
+            for (int blk = lo; blk < hi; ++blk) {
+                long long end = std::min(m, (long long)(blk + 1) * BLOCK);
+                for (long long i = (long long)blk * BLOCK; i < end; ++i)
+                    b.weight[i] = 1 + (int)(mix(seed ^ 0x57ull, (uint64_t)i) % (uint64_t)maxWeight);
+            }
+        });
+    }
+
+private:
+    static constexpr long long BLOCK = 1 << 16;
+
+    // splitmix64 of (seed, stream): independent, reproducible streams per block, row or edge
+    static uint64_t mix(uint64_t seed, uint64_t stream) {
+        uint64_t z = seed + 0x9e3779b97f4a7c15ull * (stream + 1);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    struct Rng {
+        uint64_t state;
+        Rng(uint64_t seed, uint64_t stream) : state(mix(seed, stream)) {}
+        uint64_t next() {
+            state += 0x9e3779b97f4a7c15ull;
+            uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+        double uniform() { return (double)(next() >> 11) * (1.0 / 9007199254740992.0); } // [0, 1)
+    };
+
+    // Appends per-block buffers in block order, copying blocks in parallel
+    static void concat(const std::vector<EdgeBuffer>& parts, EdgeBuffer& out) {
+        std::vector<long long> start(parts.size() + 1, 0);
+        for (size_t i = 0; i < parts.size(); ++i) start[i + 1] = start[i] + parts[i].edgeCount();
+        out.src.resize(start.back());
+        out.dst.resize(start.back());
+        Parallel::forRange(0, (int)parts.size(), 1, [&](int lo, int hi, int) {
+            for (int i = lo; i < hi; ++i) {
+                std::copy(parts[i].src.begin(), parts[i].src.end(), out.src.begin() + start[i]);
+                std::copy(parts[i].dst.begin(), parts[i].dst.end(), out.dst.begin() + start[i]);
+            }
+        });
+    }
+};
+
+#endif // GRAPH_GENERATORS_H
@@ -0,0 +1,153 @@
+#ifndef K_CORE_H
+#define K_CORE_H
+
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <climits>
+#include "../ds/CSRGraph.h"
+#include "Parallel.h"
+
+// Core decomposition of the undirected view of a graph: core[v] is the largest k such that v
+// belongs to a subgraph where every vertex has degree >= k. The maximum core number is the
+// graph's degeneracy.
+class KCore {
+public:
+    struct Result {
+        std::vector<int> core;
+        int maxCore{0};
+        std::vector<int> order;  // Batagelj–Zaversnik: vertices in peeling (degeneracy) order
+        int rounds{0};           // parallel peel: synchronous rounds
+    };
+
+    static Result compute(const CSRGraph& g, bool parallel = false) {
+        CSRGraph sym = g.symmetrize();
+        return parallel ? parallelPeel(sym) : batageljZaversnik(sym);
+    }
+
+    // Batagelj–Zaversnik: vertices bucket-sorted by degree; taking them in order and moving each
+    // unprocessed neighbour one bucket down (a swap with the bucket's first entry) is O(V + E).
+    static Result batageljZaversnik(const CSRGraph& sym) {
+        Result r;
+        int n = sym.vertexCount();
+        r.core.assign(n, 0);
+        if (n == 0) return r;
+
+        int maxDegree = 0;
+        std::vector<int> degree(n);
+        for (int u = 0; u < n; ++u) maxDegree = std::max(maxDegree, degree[u] = sym.degree(u));
+        std::vector<int> bin(maxDegree + 1, 0), pos(n);
+        r.order.resize(n);
+        for (int u = 0; u < n; ++u) ++bin[degree[u]];
+        for (int d = 0, start = 0; d <= maxDegree; ++d) {
+            int count = bin[d];
+            bin[d] = start;
+            start += count;
+        }
+        for (int u = 0; u < n; ++u) {
+            pos[u] = bin[degree[u]]++;
+            r.order[pos[u]] = u;
+        }
+        for (int d = maxDegree; d > 0; --d) bin[d] = bin[d - 1];
+        bin[0] = 0;
+
+        for (int i = 0; i < n; ++i) {
+            int u = r.order[i];
+            r.core[u] = degree[u];
+            for (const int* it = sym.neighborsBegin(u); it != sym.neighborsEnd(u); ++it) {
+                int v = *it;
+                if (degree[v] <= degree[u]) continue;
+                int dv = degree[v], pv = pos[v];
+                int pw = bin[dv], w = r.order[pw];
+                if (v != w) {
+                    std::swap(r.order[pv], r.order[pw]);
+                    pos[v] = pw;
+                    pos[w] = pv;
+                }
+                ++bin[dv];
+                --degree[v];
+            }
+            r.maxCore = std::max(r.maxCore, r.core[u]);
+        }
+        return r;
+    }
+
+    // Level-synchronous peeling: with k the smallest remaining degree, every vertex of degree <= k
+    // is removed at once (core k) and its neighbours' degrees drop atomically; a neighbour that
+    // falls to k joins the next round of the same level. Core numbers are unique, so the result is
+    // the same as the sequential one for any thread count.
+    static Result parallelPeel(const CSRGraph& sym) {
+        Result r;
+        int n = sym.vertexCount();
+        r.core.assign(n, 0);
+        if (n == 0) return r;
+
+        std::vector<std::atomic<int>> degree(n);
+        for (int u = 0; u < n; ++u) degree[u].store(sym.degree(u), std::memory_order_relaxed);
+        std::vector<char> removed(n, 0);
+        std::vector<int> remaining(n), frontier;
+        for (int u = 0; u < n; ++u) remaining[u] = u;
+        int threads = Parallel::threadCount();
+        std::vector<std::vector<int>> parts(threads);
+        std::vector<MinSlot> lowest(threads);
+        const int grain = 2048;
+
+        int k = 0;
+        while (!remaining.empty()) {
+            // Next level: the smallest degree left (never below the current one)
+            for (MinSlot& m : lowest) m.value = INT_MAX;
+            Parallel::forRange(0, (int)remaining.size(), grain, [&](int lo, int hi, int worker) {
+                for (int i = lo; i < hi; ++i)
+                    lowest[worker].value = std::min(lowest[worker].value, degree[remaining[i]].load(std::memory_order_relaxed));
+            });
+            int least = INT_MAX;
+            for (const MinSlot& m : lowest) least = std::min(least, m.value);
+            k = std::max(k, least);
+
+            Parallel::forRange(0, (int)remaining.size(), grain, [&](int lo, int hi, int worker) {
+                for (int i = lo; i < hi; ++i)
+                    if (degree[remaining[i]].load(std::memory_order_relaxed) <= k) parts[worker].push_back(remaining[i]);
+            });
+            frontier.clear();
+            for (auto& part : parts) {
+                frontier.insert(frontier.end(), part.begin(), part.end());
+                part.clear();
+            }
+
+            while (!frontier.empty()) {
+                ++r.rounds;
+                for (int u : frontier) {
+                    removed[u] = 1;
+                    r.core[u] = k;
+                }
+                Parallel::forRange(0, (int)frontier.size(), 256, [&](int lo, int hi, int worker) {
+                    for (int i = lo; i < hi; ++i) {
+                        int u = frontier[i];
+                        for (const int* it = sym.neighborsBegin(u); it != sym.neighborsEnd(u); ++it) {
+                            int v = *it;
+                            if (removed[v]) continue;
+                            // Exactly one decrement crosses k + 1 -> k, so v is queued once
+                            if (degree[v].fetch_sub(1, std::memory_order_relaxed) == k + 1) parts[worker].push_back(v);
+                        }
+                    }
+                });
+                frontier.clear();
+                for (auto& part : parts) {
+                    frontier.insert(frontier.end(), part.begin(), part.end());
+                    part.clear();
+                }
+            }
+            r.maxCore = k;
+            remaining.erase(std::remove_if(remaining.begin(), remaining.end(), [&](int u) { return removed[u] != 0; }),
+                            remaining.end());
+        }
+        return r;
+    }
+
+private:
+    struct alignas(64) MinSlot {
+        int value{INT_MAX};
+    };
+};
+
+#endif // K_CORE_H
@@ -0,0 +1,333 @@
+#ifndef MAX_FLOW_H
+#define MAX_FLOW_H
+
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <utility>
+#include "../ds/UnifiedGraph.h"
+
+// Maximum s-t flow and minimum cut over UnifiedGraph, treating each stored arc as a capacity
+// (edge weight, or 1 for unweighted graphs; negative weights count as 0). Undirected edges are
+// stored as two opposite arcs by addEdge(), which is the usual way to model them.
+class MaxFlow {
+public:
+    enum class Method { PushRelabel, Dinic };
+
+    struct Result {
+        long long value{0};
+        // edgeFlow[u][i] is the flow on graph.neighbors(u)[i]
+        std::vector<std::vector<long long>> edgeFlow;
+        // Min cut: vertices still reachable from s in the residual graph
+        std::vector<char> sourceSide;
+        // Cut arcs as (u, index into graph.neighbors(u))
+        std::vector<std::pair<int, int>> cutEdges;
+        // Pushes (push-relabel) or augmenting paths (Dinic), for comparing the two
+        long long operations{0};
+    };
+
+    static Result compute(const UnifiedGraph& g, int s, int t, Method method = Method::PushRelabel) {
+        Residual r(g);
+        Result res;
+        int n = g.vertexCount();
+        if (s < 0 || t < 0 || s >= n || t >= n || s == t) {
+            res.edgeFlow.resize(n);
+            for (int u = 0; u < n; ++u) res.edgeFlow[u].assign(g.neighbors(u).size(), 0);
+            res.sourceSide.assign(n, 0);
+            return res;
+        }
+        res.value = method == Method::Dinic ? dinic(r, s, t, res.operations) : pushRelabel(r, s, t, res.operations);
+        extract(g, r, s, res);
+        return res;
+    }
+
+private:
+    // Residual network in CSR form; arc a and rev[a] are each other's reverse
+    struct Residual {
+        int n{0};
+        std::vector<int> start;       // n + 1 offsets
+        std::vector<int> head;
+        std::vector<int> rev;
+        std::vector<long long> cap;   // residual capacity
+        std::vector<int> forwardArc;  // residual arc for the k-th input arc (flattened adjacency)
+        std::vector<int> inputStart;  // offsets of each vertex's input arcs
+
+        explicit Residual(const UnifiedGraph& g) : n(g.vertexCount()) {
+            start.assign(n + 1, 0);
+            inputStart.assign(n + 1, 0);
+            for (int u = 0; u < n; ++u) {
+                inputStart[u + 1] = inputStart[u] + (int)g.neighbors(u).size();
+                for (const auto& e : g.neighbors(u)) {
+                    ++start[u + 1];
+                    ++start[e.to + 1];
+                }
+            }
+            for (int u = 0; u < n; ++u) start[u + 1] += start[u];
+            int arcs = start[n];
+            head.resize(arcs);
+            rev.resize(arcs);
+            cap.assign(arcs, 0);
+            forwardArc.resize(inputStart[n]);
+            std::vector<int> fill(start.begin(), start.end() - 1);
+            for (int u = 0; u < n; ++u) {
+                const auto& list = g.neighbors(u);
+                for (size_t i = 0; i < list.size(); ++i) {
+                    int v = list[i].to;
+                    int a = fill[u]++, b = fill[v]++;
+                    head[a] = v; rev[a] = b; cap[a] = std::max(0, g.effectiveWeight(list[i]));
+                    head[b] = u; rev[b] = a;
+                    forwardArc[inputStart[u] + i] = a;
+                }
+            }
+        }
+
+        int tail(int a) const { return head[rev[a]]; }
+    };
+
+    // Exact distance-to-sink labels from a reverse BFS; unreachable vertices get n
+    static void globalRelabel(const Residual& r, int s, int t, std::vector<int>& h, std::vector<int>& count) {
+        int n = r.n;
+        std::fill(h.begin(), h.end(), n);
+        std::fill(count.begin(), count.end(), 0);
+        std::vector<int> queue;
+        queue.reserve(n);
+        h[t] = 0;
+        queue.push_back(t);
+        for (size_t qi = 0; qi < queue.size(); ++qi) {
+            int y = queue[qi];
+            for (int b = r.start[y]; b < r.start[y + 1]; ++b) {
+                int x = r.head[b];
+                if (h[x] == n && x != s && r.cap[r.rev[b]] > 0) {
+                    h[x] = h[y] + 1;
+                    queue.push_back(x);
+                }
+            }
+        }
+        h[s] = n;
+        for (int v = 0; v < n; ++v) ++count[h[v]];
+    }
+
+    // Highest-label push-relabel with periodic global relabelling and the gap heuristic.
+    // Phase 1 computes a maximum preflow; phase 2 sends stranded excess back to s.
+    static long long pushRelabel(Residual& r, int s, int t, long long& pushes) {
+        int n = r.n;
+        std::vector<long long> excess(n, 0);
+        std::vector<int> h(n, 0), count(2 * n + 1, 0), cur(r.start.begin(), r.start.end() - 1);
+        std::vector<std::vector<int>> buckets(n);
+        int highest = 0;
+
+        auto activate = [&](int v) {
+            if (v == s || v == t || h[v] >= n) return;
+            buckets[h[v]].push_back(v);
+            highest = std::max(highest, h[v]);
+        };
+        auto push = [&](int u, int a) {
+            int v = r.head[a];
+            long long f = std::min(excess[u], r.cap[a]);
+            bool wasIdle = excess[v] == 0;
+            r.cap[a] -= f;
+            r.cap[r.rev[a]] += f;
+            excess[u] -= f;
+            excess[v] += f;
+            ++pushes;
+            if (wasIdle) activate(v);
+        };
+        auto rebuildBuckets = [&]() {
+            for (auto& b : buckets) b.clear();
+            highest = 0;
+            for (int v = 0; v < n; ++v) if (excess[v] > 0) activate(v);
+        };
+
+        globalRelabel(r, s, t, h, count);
+        for (int a = r.start[s]; a < r.start[s + 1]; ++a) {
+            excess[s] += r.cap[a];
+            push(s, a);
+        }
+        rebuildBuckets();
+
+        long long work = 0;
+        const long long relabelPeriod = 6LL * n + (long long)r.head.size() / 2;
+        for (;;) {
+            while (highest > 0 && buckets[highest].empty()) --highest;
+            if (buckets[highest].empty()) break;
+            int u = buckets[highest].back();
+            buckets[highest].pop_back();
+            if (h[u] != highest || excess[u] == 0) continue; // stale entry
+
+            // Discharge u
+            while (excess[u] > 0) {
+                if (cur[u] == r.start[u + 1]) {
+                    int old = h[u], lowest = 2 * n;
+                    for (int a = r.start[u]; a < r.start[u + 1]; ++a)
+                        if (r.cap[a] > 0) lowest = std::min(lowest, h[r.head[a]] + 1);
+                    h[u] = std::min(lowest, n);
+                    --count[old];
+                    ++count[h[u]];
+                    cur[u] = r.start[u];
+                    work += r.start[u + 1] - r.start[u] + 12;
+                    // Gap: nobody is left at `old`, so everything above it is cut off from t
+                    if (count[old] == 0 && old < n) {
+                        for (int v = 0; v < n; ++v) {
+                            if (v != s && h[v] > old && h[v] < n) {
+                                --count[h[v]];
+                                h[v] = n;
+                                ++count[n];
+                            }
+                        }
+                        h[u] = n;
+                    }
+                    if (h[u] >= n) break;
+                    continue;
+                }
+                int a = cur[u];
+                if (r.cap[a] > 0 && h[u] == h[r.head[a]] + 1) push(u, a);
+                else ++cur[u];
+            }
+            if (excess[u] > 0 && h[u] < n) activate(u);
+
+            if (work > relabelPeriod) {
+                work = 0;
+                globalRelabel(r, s, t, h, count);
+                std::copy(r.start.begin(), r.start.end() - 1, cur.begin());
+                rebuildBuckets();
+            }
+        }
+        long long value = excess[t];
+
+        // Phase 2: distances to s over residual arcs, then FIFO discharge towards s
+        std::vector<int> d(n, -1);
+        std::vector<int> queue{s};
+        d[s] = 0;
+        for (size_t qi = 0; qi < queue.size(); ++qi) {
+            int y = queue[qi];
+            for (int b = r.start[y]; b < r.start[y + 1]; ++b) {
+                int x = r.head[b];
+                if (d[x] < 0 && x != t && r.cap[r.rev[b]] > 0) { d[x] = d[y] + 1; queue.push_back(x); }
+            }
+        }
+        for (int v = 0; v < n; ++v) h[v] = d[v] < 0 ? 2 * n : n + d[v];
+        h[t] = 0;
+        std::copy(r.start.begin(), r.start.end() - 1, cur.begin());
+        std::queue<int> fifo;
+        for (int v = 0; v < n; ++v) if (v != s && v != t && excess[v] > 0) fifo.push(v);
+        while (!fifo.empty()) {
+            int u = fifo.front();
+            fifo.pop();
+            while (excess[u] > 0) {
+                if (cur[u] == r.start[u + 1]) {
+                    int lowest = 4 * n;
+                    for (int a = r.start[u]; a < r.start[u + 1]; ++a)
+                        if (r.cap[a] > 0 && r.head[a] != t) lowest = std::min(lowest, h[r.head[a]] + 1);
+                    h[u] = lowest;
+                    cur[u] = r.start[u];
+                    continue;
+                }
+                int a = cur[u];
+                int v = r.head[a];
+                if (v != t && r.cap[a] > 0 && h[u] == h[v] + 1) {
+                    bool wasIdle = excess[v] == 0;
+                    push(u, a);
+                    if (wasIdle && v != s) fifo.push(v);
+                } else {
+                    ++cur[u];
+                }
+            }
+        }
+        return value;
+    }
+
+    // Dinic: BFS level graph, then blocking flow with an explicit path stack (no recursion)
+    static long long dinic(Residual& r, int s, int t, long long& paths) {
+        int n = r.n;
+        long long total = 0;
+        std::vector<int> level(n), cur(n), path;
+        std::vector<int> queue;
+        queue.reserve(n);
+        for (;;) {
+            std::fill(level.begin(), level.end(), -1);
+            queue.clear();
+            level[s] = 0;
+            queue.push_back(s);
+            for (size_t qi = 0; qi < queue.size(); ++qi) {
+                int u = queue[qi];
+                for (int a = r.start[u]; a < r.start[u + 1]; ++a) {
+                    int v = r.head[a];
+                    if (r.cap[a] > 0 && level[v] < 0) { level[v] = level[u] + 1; queue.push_back(v); }
+                }
+            }
+            if (level[t] < 0) break;
+            std::copy(r.start.begin(), r.start.end() - 1, cur.begin());
+
+            path.clear();
+            int u = s;
+            for (;;) {
+                if (u == t) {
+                    long long f = r.cap[path[0]];
+                    for (int a : path) f = std::min(f, r.cap[a]);
+                    size_t cut = path.size();
+                    for (size_t i = 0; i < path.size(); ++i) {
+                        r.cap[path[i]] -= f;
+                        r.cap[r.rev[path[i]]] += f;
+                        if (r.cap[path[i]] == 0 && cut == path.size()) cut = i;
+                    }
+                    total += f;
+                    ++paths;
+                    // Retreat to the tail of the first saturated arc
+                    u = r.tail(path[cut]);
+                    path.resize(cut);
+                    continue;
+                }
+                bool advanced = false;
+                for (; cur[u] < r.start[u + 1]; ++cur[u]) {
+                    int a = cur[u];
+                    int v = r.head[a];
+                    if (r.cap[a] > 0 && level[v] == level[u] + 1) {
+                        path.push_back(a);
+                        u = v;
+                        advanced = true;
+                        break;
+                    }
+                }
+                if (advanced) continue;
+                level[u] = -1; // dead end for this phase
+                if (u == s) break;
+                int a = path.back();
+                path.pop_back();
+                u = r.tail(a);
+                ++cur[u];
+            }
+        }
+        return total;
+    }
+
+    static void extract(const UnifiedGraph& g, const Residual& r, int s, Result& res) {
+        int n = g.vertexCount();
+        res.edgeFlow.resize(n);
+        for (int u = 0; u < n; ++u) {
+            const auto& list = g.neighbors(u);
+            res.edgeFlow[u].resize(list.size());
+            for (size_t i = 0; i < list.size(); ++i) {
+                int a = r.forwardArc[r.inputStart[u] + i];
+                res.edgeFlow[u][i] = std::max(0, g.effectiveWeight(list[i])) - r.cap[a];
+            }
+        }
+        res.sourceSide.assign(n, 0);
+        std::vector<int> queue{s};
+        res.sourceSide[s] = 1;
+        for (size_t qi = 0; qi < queue.size(); ++qi) {
+            int u = queue[qi];
+            for (int a = r.start[u]; a < r.start[u + 1]; ++a) {
+                int v = r.head[a];
+                if (r.cap[a] > 0 && !res.sourceSide[v]) { res.sourceSide[v] = 1; queue.push_back(v); }
+            }
+        }
+        for (int u = 0; u < n; ++u) {
+            if (!res.sourceSide[u]) continue;
+            const auto& list = g.neighbors(u);
+            for (size_t i = 0; i < list.size(); ++i)
+                if (!res.sourceSide[list[i].to]) res.cutEdges.emplace_back(u, (int)i);
+        }
+    }
+};
+
+#endif // MAX_FLOW_H
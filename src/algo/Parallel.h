@@ -0,0 +1,67 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Minimal fork-join helper shared by the graph engines.
+// Work is handed out in chunks from an atomic counter so uneven chunks balance themselves.
+class Parallel {
+public:
+    static int threadCount() {
+        unsigned hc = std::thread::hardware_concurrency();
+        return hc == 0 ? 1 : (int)std::min(hc, 64u);
+    }
+
+    // Calls fn(lo, hi, worker) for consecutive chunks of [begin, end) of at most `grain` items.
+    // `worker` is in [0, threadCount()) and is stable for the duration of one call,
+    // so callers can index per-thread scratch buffers with it.
+    template <class F>
+    static void forRange(int begin, int end, int grain, F&& fn) {
+        if (end <= begin) return;
+        grain = std::max(1, grain);
+        int chunks = (end - begin + grain - 1) / grain;
+        int workers = std::min(threadCount(), chunks);
+        if (workers <= 1) {
+            fn(begin, end, 0);
+            return;
+        }
+        std::atomic<int> next{begin};
+        auto run = [&](int worker) {
+            for (;;) {
+                int lo = next.fetch_add(grain);
+                if (lo >= end) break;
+                fn(lo, std::min(end, lo + grain), worker);
+            }
+        };
+        std::vector<std::thread> pool;
+        pool.reserve(workers - 1);
+        for (int w = 1; w < workers; ++w) pool.emplace_back(run, w);
+        run(0);
+        for (auto& t : pool) t.join();
+    }
+
+    // Sorts in place: one std::sort per thread over equal slices, then rounds of pairwise merges
+    // (each round's merges run side by side). Small inputs go straight to std::sort.
+    template <class T>
+    static void sort(std::vector<T>& data) {
+        int n = (int)data.size();
+        int parts = 1;
+        while (parts * 2 <= threadCount() && n / (parts * 2) >= 32768) parts *= 2;
+        if (parts == 1) {
+            std::sort(data.begin(), data.end());
+            return;
+        }
+        auto bound = [&](int part) { return data.begin() + (long long)n * part / parts; };
+        forRange(0, parts, 1, [&](int lo, int, int) { std::sort(bound(lo), bound(lo + 1)); });
+        for (int width = 1; width < parts; width *= 2)
+            forRange(0, parts / (2 * width), 1, [&](int lo, int, int) {
+                int first = lo * 2 * width;
+                std::inplace_merge(bound(first), bound(first + width), bound(first + 2 * width));
+            });
+    }
+};
+
+#endif // PARALLEL_H
@@ -0,0 +1,180 @@
+#ifndef TIDY_TREE_LAYOUT_H
+#define TIDY_TREE_LAYOUT_H
+
+#include <vector>
+#include <algorithm>
+#include "../ds/Tree.h"
+
+// Reingold–Tilford tidy drawing of a BSTree (or the current version of a PersistentTree) in O(n):
+// each node sits one level below its parent, left children to the left and right children to the
+// right, siblings are centred under their parent, and no two nodes on a level come closer than
+// one unit. Subtrees are pushed apart only as far as their facing contours require, so wide or
+// lopsided trees stay compact where they can.
+//
+// A postorder pass fixes, per node, the offset of its children; the contours of a subtree are
+// walked through its children and, below a shorter subtree, through threads to the taller one,
+// so each join costs the height of the shorter side and the whole pass is linear. A preorder
+// pass then turns offsets into coordinates. Both passes use explicit stacks, as a plain BST from
+// sorted input can be as deep as it is large.
+class TidyTreeLayout {
+public:
+    static constexpr int NIL = BSTree::NIL; // PersistentTree::NIL too
+
+    // Indexed by node index; slots of free nodes (or of other versions) are left at 0
+    std::vector<double> x;  // units: neighbours on a level are >= 1 apart; the root is at 0
+    std::vector<int> depth; // root = 0
+    double minX{0}, maxX{0};
+    int height{-1};         // deepest level, -1 when empty
+
+    // Bounding box of each node's subtree: x from spanMin to spanMax, levels from depth to bottom.
+    // A box contains its children's boxes, so the tree itself is the spatial index: a viewer
+    // descends from the root and drops every subtree whose box is off screen or too small to see.
+    std::vector<double> spanMin, spanMax;
+    std::vector<int> bottom;
+
+    template <class Tree>
+    static TidyTreeLayout compute(const Tree& tree) {
+        TidyTreeLayout out;
+        int nodeSlots = tree.slotCount();
+        out.x.assign(nodeSlots, 0.0);
+        out.depth.assign(nodeSlots, 0);
+        out.spanMin.assign(nodeSlots, 0.0);
+        out.spanMax.assign(nodeSlots, 0.0);
+        out.bottom.assign(nodeSlots, 0);
+        int root = tree.root();
+        if (root == NIL) return out;
+
+        std::vector<Work> w(nodeSlots);
+        std::vector<int> order; // postorder
+        order.reserve(tree.size());
+        std::vector<std::pair<int, bool>> stack{{root, false}};
+        while (!stack.empty()) {
+            auto [n, expanded] = stack.back();
+            stack.pop_back();
+            if (expanded) { order.push_back(n); continue; }
+            stack.push_back({n, true});
+            const auto& node = tree.node(n);
+            if (node.right != NIL) stack.push_back({node.right, false});
+            if (node.left != NIL) stack.push_back({node.left, false});
+        }
+
+        for (int n : order) join(tree, w, n);
+
+        // Offsets to coordinates, parents before children
+        std::vector<int> pending{root};
+        out.x[root] = 0;
+        order.clear(); // now preorder
+        while (!pending.empty()) {
+            int n = pending.back();
+            pending.pop_back();
+            order.push_back(n);
+            const auto& node = tree.node(n);
+            out.minX = std::min(out.minX, out.x[n]);
+            out.maxX = std::max(out.maxX, out.x[n]);
+            out.height = std::max(out.height, out.depth[n]);
+            for (int c : {node.left, node.right}) {
+                if (c == NIL) continue;
+                out.x[c] = out.x[n] + (c == node.left ? -w[n].offset : w[n].offset);
+                out.depth[c] = out.depth[n] + 1;
+                pending.push_back(c);
+            }
+        }
+
+        // Subtree boxes, children before parents
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            int n = *it;
+            const auto& node = tree.node(n);
+            out.spanMin[n] = out.spanMax[n] = out.x[n];
+            out.bottom[n] = out.depth[n];
+            for (int c : {node.left, node.right}) {
+                if (c == NIL) continue;
+                out.spanMin[n] = std::min(out.spanMin[n], out.spanMin[c]);
+                out.spanMax[n] = std::max(out.spanMax[n], out.spanMax[c]);
+                out.bottom[n] = std::max(out.bottom[n], out.bottom[c]);
+            }
+        }
+        return out;
+    }
+
+private:
+    struct Work {
+        double offset{0};        // children sit at -offset / +offset
+        int thread{NIL}; // leaves only: next contour node below this subtree
+        double threadX{0};       // its x relative to this node
+        // Deepest leftmost / rightmost nodes of the subtree, x relative to this node
+        int leftmost{NIL}, rightmost{NIL};
+        double leftmostX{0}, rightmostX{0};
+        int levels{0};           // depth of the deepest node below this one
+    };
+
+    // Next node down the left (or right) contour and its x relative to n
+    template <class Tree>
+    static int nextContour(const Tree& tree, const std::vector<Work>& w, int n, bool leftSide, double& dx) {
+        const auto& node = tree.node(n);
+        int first = leftSide ? node.left : node.right, second = leftSide ? node.right : node.left;
+        if (first != NIL) { dx = leftSide ? -w[n].offset : w[n].offset; return first; }
+        if (second != NIL) { dx = leftSide ? w[n].offset : -w[n].offset; return second; }
+        dx = w[n].threadX;
+        return w[n].thread;
+    }
+
+    template <class Tree>
+    static void join(const Tree& tree, std::vector<Work>& w, int n) {
+        const auto& node = tree.node(n);
+        int l = node.left, r = node.right;
+        Work& v = w[n];
+        if (l == NIL && r == NIL) {
+            v.leftmost = v.rightmost = n;
+            return;
+        }
+        if (l == NIL || r == NIL) {
+            // A lone child still leans to its side so the drawing shows which side it is on
+            int c = l != NIL ? l : r;
+            double dx = c == l ? -0.5 : 0.5;
+            v.offset = 0.5;
+            v.leftmost = w[c].leftmost; v.leftmostX = dx + w[c].leftmostX;
+            v.rightmost = w[c].rightmost; v.rightmostX = dx + w[c].rightmostX;
+            v.levels = w[c].levels + 1;
+            return;
+        }
+
+        // Walk the right contour of l against the left contour of r, level by level, widening the
+        // gap wherever they come closer than one unit
+        double offset = 0.5;
+        int lo = l, ro = r;
+        double lx = 0, rx = 0; // relative to l and r
+        while (lo != NIL && ro != NIL) {
+            double gap = 2 * offset + rx - lx;
+            if (gap < 1.0) offset += (1.0 - gap) / 2;
+            double dl, dr;
+            lo = nextContour(tree, w, lo, false, dl);
+            ro = nextContour(tree, w, ro, true, dr);
+            if (lo != NIL) lx += dl;
+            if (ro != NIL) rx += dr;
+        }
+        v.offset = offset;
+
+        // Thread the shorter side's outer contour on into the taller subtree
+        if (ro != NIL) {
+            // r is taller: l's left contour continues down r's left contour
+            Work& leaf = w[w[l].leftmost];
+            leaf.thread = ro;
+            leaf.threadX = (offset + rx) - (-offset + w[l].leftmostX);
+        } else if (lo != NIL) {
+            // l is taller: r's right contour continues down l's right contour
+            Work& leaf = w[w[r].rightmost];
+            leaf.thread = lo;
+            leaf.threadX = (-offset + lx) - (offset + w[r].rightmostX);
+        }
+
+        int hl = w[l].levels, hr = w[r].levels;
+        const Work& deepLeft = hl >= hr ? w[l] : w[r];
+        const Work& deepRight = hr >= hl ? w[r] : w[l];
+        double leftShift = hl >= hr ? -offset : offset, rightShift = hr >= hl ? offset : -offset;
+        v.leftmost = deepLeft.leftmost; v.leftmostX = leftShift + deepLeft.leftmostX;
+        v.rightmost = deepRight.rightmost; v.rightmostX = rightShift + deepRight.rightmostX;
+        v.levels = std::max(hl, hr) + 1;
+    }
+};
+
+#endif // TIDY_TREE_LAYOUT_H
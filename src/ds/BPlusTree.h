@@ -0,0 +1,472 @@
+#ifndef BPLUS_TREE_H
+#define BPLUS_TREE_H
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include "../algo/Parallel.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// B+-tree over unique int keys. Every key lives in a leaf; inner nodes hold only separators
+// (separator i is the smallest key of child i + 1 when it was set, so stale separators left by
+// removes still route correctly), and the leaves are chained left to right for range scans.
+//
+// The fanout is the most children an inner node may have; every node holds at most fanout - 1
+// keys and, except the root, at least half of that. A node's keys sit in one contiguous slot of
+// `fanout` ints (one spare for the overflow before a split), so fanoutForBytes(64) gives one
+// cache line of keys per node and fanoutForBytes(4096) one page. Searching within a node counts
+// the keys below the target with SSE2/AVX2 compares instead of branching per key.
+//
+// Like BSTree, nodes live in an arena addressed by int index with a free list, nothing recurses,
+// and the splits, borrows and merges of the last insert/remove are reported in lastEvents() so a
+// view can animate them.
+class BPlusTree {
+public:
+    static constexpr int NIL = -1;
+
+    struct Node {
+        bool leaf;
+        int count;  // keys in use
+        int next;   // leaves: right neighbour (free list link when released)
+        int prev;   // leaves: left neighbour
+    };
+
+    struct Event {
+        enum Kind { Split, NewRoot, Borrow, Merge, ShrinkRoot } kind;
+        int node;   // Split: the node that overflowed; Borrow: the receiver; Merge: the survivor
+        int other;  // Split: the new right sibling; Borrow: the donor; Merge: the node released
+    };
+
+    explicit BPlusTree(int fanout = 16) : fanout_(std::max(3, fanout)), maxKeys_(fanout_ - 1), minKeys_(maxKeys_ / 2) {}
+
+    // Largest fanout whose keys fit in `bytes` (64 for a cache line, 4096 for a page)
+    static int fanoutForBytes(int bytes) { return std::max(3, bytes / (int)sizeof(int)); }
+
+    int fanout() const { return fanout_; }
+    int size() const { return count_; }
+    int nodeCount() const { return (int)nodes_.size() - released_; }
+    size_t memoryBytes() const {
+        return nodes_.capacity() * sizeof(Node) + (keys_.capacity() + children_.capacity()) * sizeof(int);
+    }
+
+    // Levels, leaves included; 0 when empty
+    int height() const {
+        int h = 0;
+        for (int n = root_; n != NIL; n = nodes_[n].leaf ? NIL : child(n, 0)) ++h;
+        return h;
+    }
+
+    int root() const { return root_; }
+    const Node& node(int n) const { return nodes_[n]; }
+    int key(int n, int i) const { return keys_[(size_t)n * fanout_ + i]; }
+    int child(int n, int i) const { return children_[(size_t)n * (fanout_ + 1) + i]; }
+    int firstLeaf() const {
+        int n = root_;
+        while (n != NIL && !nodes_[n].leaf) n = child(n, 0);
+        return n;
+    }
+
+    const std::vector<Event>& lastEvents() const { return events_; }
+
+    bool contains(int v) const {
+        if (root_ == NIL) return false;
+        int n = root_;
+        while (!nodes_[n].leaf) n = child(n, childIndex(n, v));
+        int i = lessCount(keysOf(n), nodes_[n].count, v);
+        return i < nodes_[n].count && key(n, i) == v;
+    }
+
+    // Nodes from the root to the leaf where v is or would be
+    std::vector<int> searchPath(int v) const {
+        std::vector<int> path;
+        for (int n = root_; n != NIL; n = nodes_[n].leaf ? NIL : child(n, childIndex(n, v))) path.push_back(n);
+        return path;
+    }
+
+    bool insert(int v) {
+        events_.clear();
+        if (root_ == NIL) {
+            root_ = allocate(true);
+            keysOf(root_)[0] = v;
+            nodes_[root_].count = 1;
+            ++count_;
+            return true;
+        }
+        int leaf = descend(v);
+        int* k = keysOf(leaf);
+        int& c = nodes_[leaf].count;
+        int i = lessCount(k, c, v);
+        if (i < c && k[i] == v) return false; // no duplicates
+        std::copy_backward(k + i, k + c, k + c + 1);
+        k[i] = v;
+        ++c;
+        ++count_;
+        if (c > maxKeys_) splitUpward(leaf);
+        return true;
+    }
+
+    bool remove(int v) {
+        events_.clear();
+        if (root_ == NIL) return false;
+        int leaf = descend(v);
+        int* k = keysOf(leaf);
+        int& c = nodes_[leaf].count;
+        int i = lessCount(k, c, v);
+        if (i == c || k[i] != v) return false;
+        std::copy(k + i + 1, k + c, k + i);
+        --c;
+        --count_;
+        if (leaf == root_) {
+            if (c == 0) {
+                release(root_);
+                root_ = NIL;
+            }
+            return true;
+        }
+        if (c < minKeys_) fixUnderflow();
+        return true;
+    }
+
+    // Calls fn(key) for every key in [lo, hi] in ascending order, walking the leaf chain
+    template <class F>
+    void scan(int lo, int hi, F&& fn) const {
+        if (root_ == NIL || lo > hi) return;
+        int n = root_;
+        while (!nodes_[n].leaf) n = child(n, childIndex(n, lo));
+        int i = lessCount(keysOf(n), nodes_[n].count, lo);
+        for (; n != NIL; n = nodes_[n].next, i = 0) {
+            const int* k = keysOf(n);
+            for (; i < nodes_[n].count; ++i) {
+                if (k[i] > hi) return;
+                fn(k[i]);
+            }
+        }
+    }
+
+    std::vector<int> range(int lo, int hi) const {
+        std::vector<int> out;
+        scan(lo, hi, [&](int v) { out.push_back(v); });
+        return out;
+    }
+
+    std::vector<int> keys() const {
+        std::vector<int> out;
+        out.reserve(count_);
+        for (int n = firstLeaf(); n != NIL; n = nodes_[n].next) out.insert(out.end(), keysOf(n), keysOf(n) + nodes_[n].count);
+        return out;
+    }
+
+    void clear() {
+        nodes_.clear();
+        keys_.clear();
+        children_.clear();
+        events_.clear();
+        root_ = NIL;
+        count_ = 0;
+        free_ = NIL;
+        released_ = 0;
+    }
+
+    // Replaces the contents with `values` (any order, duplicates dropped), built bottom-up in
+    // O(n) after the sort: leaves are packed to `fill` of capacity (1.0 suits read-mostly data;
+    // lower leaves room for inserts before the first splits), then each level above is built
+    // from the one below. Returns the number of keys kept.
+    int bulkLoad(std::vector<int> values, double fill = 1.0) {
+        clear();
+        Parallel::sort(values);
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        int n = (int)values.size();
+        if (n == 0) return 0;
+        count_ = n;
+
+        // Leaves, sizes spread evenly so none falls below half full
+        int perLeaf = std::max(std::max(minKeys_, 1), std::min(maxKeys_, (int)(maxKeys_ * fill)));
+        int leaves = std::min((n + perLeaf - 1) / perLeaf, std::max(1, n / std::max(minKeys_, 1)));
+        std::vector<int> level, lowest; // nodes of the level just built and their smallest keys
+        level.reserve(leaves);
+        lowest.reserve(leaves);
+        int prev = NIL;
+        for (int j = 0, at = 0; j < leaves; ++j) {
+            int take = n / leaves + (j < n % leaves);
+            int leaf = allocate(true);
+            std::copy(values.begin() + at, values.begin() + at + take, keysOf(leaf));
+            nodes_[leaf].count = take;
+            nodes_[leaf].prev = prev;
+            if (prev != NIL) nodes_[prev].next = leaf;
+            prev = leaf;
+            level.push_back(leaf);
+            lowest.push_back(values[at]);
+            at += take;
+        }
+
+        std::vector<int> upper, upperLowest;
+        while (level.size() > 1) {
+            int m = (int)level.size();
+            int parents = (m + fanout_ - 1) / fanout_;
+            upper.clear();
+            upperLowest.clear();
+            for (int j = 0, at = 0; j < parents; ++j) {
+                int take = m / parents + (j < m % parents);
+                int inner = allocate(false);
+                for (int c = 0; c < take; ++c) {
+                    childSlot(inner, c) = level[at + c];
+                    if (c > 0) keysOf(inner)[c - 1] = lowest[at + c];
+                }
+                nodes_[inner].count = take - 1;
+                upper.push_back(inner);
+                upperLowest.push_back(lowest[at]);
+                at += take;
+            }
+            level.swap(upper);
+            lowest.swap(upperLowest);
+        }
+        root_ = level[0];
+        return n;
+    }
+
+private:
+    int fanout_, maxKeys_, minKeys_;
+    std::vector<Node> nodes_;
+    std::vector<int> keys_;     // fanout_ slots per node
+    std::vector<int> children_; // fanout_ + 1 slots per node
+    std::vector<Event> events_;
+    int root_{NIL};
+    int count_{0};
+    int free_{NIL};
+    int released_{0};
+    // Last descent: the nodes from the root down and the child taken at each
+    struct Step { int node, child; };
+    std::vector<Step> path_;
+
+    int* keysOf(int n) { return keys_.data() + (size_t)n * fanout_; }
+    const int* keysOf(int n) const { return keys_.data() + (size_t)n * fanout_; }
+    int& childSlot(int n, int i) { return children_[(size_t)n * (fanout_ + 1) + i]; }
+    int* childrenOf(int n) { return children_.data() + (size_t)n * (fanout_ + 1); }
+
+    int allocate(bool leaf) {
+        int n;
+        if (free_ != NIL) {
+            n = free_;
+            free_ = nodes_[n].next;
+            --released_;
+        } else {
+            n = (int)nodes_.size();
+            nodes_.push_back({});
+            keys_.resize(keys_.size() + fanout_);
+            children_.resize(children_.size() + fanout_ + 1);
+        }
+        nodes_[n] = {leaf, 0, NIL, NIL};
+        return n;
+    }
+
+    void release(int n) {
+        nodes_[n].next = free_;
+        free_ = n;
+        ++released_;
+    }
+
+    // Keys of a sorted run below v. Long runs (page-sized nodes) are first narrowed by binary
+    // search; the rest is counted in vector compares, whose lane masks add up to the position.
+    static int lessCount(const int* k, int n, int v) {
+        int lo = 0;
+        while (n > 64) {
+            int half = n / 2;
+            if (k[lo + half] < v) { lo += half + 1; n -= half + 1; }
+            else n = half;
+        }
+        int i = 0, below = 0;
+#if defined(__AVX2__)
+        __m256i vv = _mm256_set1_epi32(v);
+        for (; i + 8 <= n; i += 8) {
+            __m256i lt = _mm256_cmpgt_epi32(vv, _mm256_loadu_si256((const __m256i*)(k + lo + i)));
+            below += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(lt)));
+        }
+#endif
+#if defined(__SSE2__)
+        __m128i v4 = _mm_set1_epi32(v);
+        for (; i + 4 <= n; i += 4) {
+            __m128i lt = _mm_cmpgt_epi32(v4, _mm_loadu_si128((const __m128i*)(k + lo + i)));
+            below += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(lt)));
+        }
+#endif
+        for (; i < n; ++i) below += k[lo + i] < v;
+        return lo + below;
+    }
+
+    // Child of inner node n to follow for v: one past every separator <= v
+    int childIndex(int n, int v) const {
+        const int* k = keysOf(n);
+        int c = nodes_[n].count;
+        int i = lessCount(k, c, v);
+        return i + (i < c && k[i] == v);
+    }
+
+    // Walks to v's leaf, recording the path for the split/underflow fix-ups
+    int descend(int v) {
+        path_.clear();
+        int n = root_;
+        while (!nodes_[n].leaf) {
+            int i = childIndex(n, v);
+            path_.push_back({n, i});
+            n = child(n, i);
+        }
+        return n;
+    }
+
+    // Splits the overflowing leaf, then every ancestor its new separator overflows
+    void splitUpward(int n) {
+        for (int depth = (int)path_.size();; --depth) {
+            int right = allocate(nodes_[n].leaf);
+            int* k = keysOf(n);
+            int c = nodes_[n].count;
+            int up;
+            if (nodes_[n].leaf) {
+                int keep = c / 2;
+                std::copy(k + keep, k + c, keysOf(right));
+                nodes_[right].count = c - keep;
+                nodes_[n].count = keep;
+                nodes_[right].next = nodes_[n].next;
+                nodes_[right].prev = n;
+                if (nodes_[n].next != NIL) nodes_[nodes_[n].next].prev = right;
+                nodes_[n].next = right;
+                up = keysOf(right)[0];
+            } else {
+                // The middle separator moves up instead of being copied
+                int mid = c / 2;
+                up = k[mid];
+                std::copy(k + mid + 1, k + c, keysOf(right));
+                std::copy(childrenOf(n) + mid + 1, childrenOf(n) + c + 1, childrenOf(right));
+                nodes_[right].count = c - mid - 1;
+                nodes_[n].count = mid;
+            }
+            events_.push_back({Event::Split, n, right});
+
+            if (depth == 0) {
+                root_ = allocate(false);
+                keysOf(root_)[0] = up;
+                childSlot(root_, 0) = n;
+                childSlot(root_, 1) = right;
+                nodes_[root_].count = 1;
+                events_.push_back({Event::NewRoot, root_, n});
+                return;
+            }
+            int parent = path_[depth - 1].node, at = path_[depth - 1].child;
+            int* pk = keysOf(parent);
+            int* pc = childrenOf(parent);
+            int& pcount = nodes_[parent].count;
+            std::copy_backward(pk + at, pk + pcount, pk + pcount + 1);
+            std::copy_backward(pc + at + 1, pc + pcount + 1, pc + pcount + 2);
+            pk[at] = up;
+            pc[at + 1] = right;
+            ++pcount;
+            if (pcount <= maxKeys_) return;
+            n = parent;
+        }
+    }
+
+    // The leaf at the end of path_ fell below half full: borrow from a sibling that can spare a
+    // key, otherwise merge with one, which takes a separator from the parent and may repeat the
+    // fix one level up
+    void fixUnderflow() {
+        int n = path_.empty() ? root_ : child(path_.back().node, path_.back().child);
+        for (int depth = (int)path_.size(); depth > 0; --depth) {
+            int parent = path_[depth - 1].node, at = path_[depth - 1].child;
+            int left = at > 0 ? child(parent, at - 1) : NIL;
+            int right = at < nodes_[parent].count ? child(parent, at + 1) : NIL;
+            bool leaf = nodes_[n].leaf;
+
+            if (left != NIL && nodes_[left].count > minKeys_) {
+                borrowFromLeft(parent, at, left, n, leaf);
+                events_.push_back({Event::Borrow, n, left});
+                return;
+            }
+            if (right != NIL && nodes_[right].count > minKeys_) {
+                borrowFromRight(parent, at, n, right, leaf);
+                events_.push_back({Event::Borrow, n, right});
+                return;
+            }
+            // Merge the right one of the pair into the left one
+            int into = left != NIL ? left : n, gone = left != NIL ? n : right;
+            int sep = left != NIL ? at - 1 : at;
+            mergeInto(parent, sep, into, gone, leaf);
+            events_.push_back({Event::Merge, into, gone});
+
+            if (parent == root_ && nodes_[parent].count == 0) {
+                release(root_);
+                root_ = into;
+                events_.push_back({Event::ShrinkRoot, into, parent});
+                return;
+            }
+            if (parent == root_ || nodes_[parent].count >= minKeys_) return;
+            n = parent;
+        }
+    }
+
+    void borrowFromLeft(int parent, int at, int left, int n, bool leaf) {
+        int* k = keysOf(n);
+        int c = nodes_[n].count;
+        int lc = nodes_[left].count;
+        std::copy_backward(k, k + c, k + c + 1);
+        if (leaf) {
+            k[0] = keysOf(left)[lc - 1];
+            keysOf(parent)[at - 1] = k[0];
+        } else {
+            std::copy_backward(childrenOf(n), childrenOf(n) + c + 1, childrenOf(n) + c + 2);
+            k[0] = keysOf(parent)[at - 1];
+            childSlot(n, 0) = child(left, lc);
+            keysOf(parent)[at - 1] = keysOf(left)[lc - 1];
+        }
+        ++nodes_[n].count;
+        --nodes_[left].count;
+    }
+
+    void borrowFromRight(int parent, int at, int n, int right, bool leaf) {
+        int* k = keysOf(n);
+        int* rk = keysOf(right);
+        int c = nodes_[n].count;
+        int rc = nodes_[right].count;
+        if (leaf) {
+            k[c] = rk[0];
+            std::copy(rk + 1, rk + rc, rk);
+            keysOf(parent)[at] = rk[0];
+        } else {
+            k[c] = keysOf(parent)[at];
+            childSlot(n, c + 1) = child(right, 0);
+            keysOf(parent)[at] = rk[0];
+            std::copy(rk + 1, rk + rc, rk);
+            std::copy(childrenOf(right) + 1, childrenOf(right) + rc + 1, childrenOf(right));
+        }
+        ++nodes_[n].count;
+        --nodes_[right].count;
+    }
+
+    // Appends `gone` (the right neighbour of `into` under separator sep) to `into` and releases it
+    void mergeInto(int parent, int sep, int into, int gone, bool leaf) {
+        int* k = keysOf(into);
+        int c = nodes_[into].count;
+        int gc = nodes_[gone].count;
+        if (leaf) {
+            std::copy(keysOf(gone), keysOf(gone) + gc, k + c);
+            nodes_[into].count = c + gc;
+            nodes_[into].next = nodes_[gone].next;
+            if (nodes_[gone].next != NIL) nodes_[nodes_[gone].next].prev = into;
+        } else {
+            k[c] = keysOf(parent)[sep];
+            std::copy(keysOf(gone), keysOf(gone) + gc, k + c + 1);
+            std::copy(childrenOf(gone), childrenOf(gone) + gc + 1, childrenOf(into) + c + 1);
+            nodes_[into].count = c + gc + 1;
+        }
+        int* pk = keysOf(parent);
+        int* pc = childrenOf(parent);
+        int& pcount = nodes_[parent].count;
+        std::copy(pk + sep + 1, pk + pcount, pk + sep);
+        std::copy(pc + sep + 2, pc + pcount + 1, pc + sep + 1);
+        --pcount;
+        release(gone);
+    }
+};
+
+#endif // BPLUS_TREE_H
@@ -0,0 +1,181 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include "UnifiedGraph.h"
+
+// Read-only compressed sparse row snapshot of a UnifiedGraph.
+// Neighbours of u are targets[offsets[u] .. offsets[u + 1]), with parallel weights.
+// Analytics kernels run on this layout instead of vector-of-vectors so every sweep is sequential.
+class CSRGraph {
+public:
+    CSRGraph() = default;
+
+    static CSRGraph freeze(const UnifiedGraph& g) {
+        CSRGraph c;
+        int n = g.vertexCount();
+        c.directed = g.isDirected();
+        c.weighted = g.isWeighted();
+        c.offsets.assign(n + 1, 0);
+        for (int u = 0; u < n; ++u) c.offsets[u + 1] = c.offsets[u] + (long long)g.neighbors(u).size();
+        c.targets.resize(c.offsets[n]);
+        c.weights.resize(c.offsets[n]);
+        for (int u = 0; u < n; ++u) {
+            long long k = c.offsets[u];
+            for (const auto& e : g.neighbors(u)) {
+                c.targets[k] = e.to;
+                c.weights[k] = g.effectiveWeight(e);
+                ++k;
+            }
+        }
+        return c;
+    }
+
+    // Canonical snapshot: every neighbour list sorted by target, parallel arcs merged (the lightest
+    // weight wins) and self-loops dropped. addEdge() keeps insertion order and duplicates, so kernels
+    // that intersect adjacency lists must start from this form.
+    static CSRGraph freezeCanonical(const UnifiedGraph& g) {
+        CSRGraph c;
+        int n = g.vertexCount();
+        c.directed = g.isDirected();
+        c.weighted = g.isWeighted();
+        c.sorted = true;
+        c.offsets.assign(n + 1, 0);
+        c.targets.reserve(g.arcCount());
+        c.weights.reserve(g.arcCount());
+        std::vector<std::pair<int, int>> row;
+        for (int u = 0; u < n; ++u) {
+            row.clear();
+            for (const auto& e : g.neighbors(u))
+                if (e.to != u) row.emplace_back(e.to, g.effectiveWeight(e));
+            std::sort(row.begin(), row.end());
+            for (size_t i = 0; i < row.size(); ++i) {
+                if (i > 0 && row[i].first == row[i - 1].first) continue; // sorted by weight too: first is lightest
+                c.targets.push_back(row[i].first);
+                c.weights.push_back(row[i].second);
+            }
+            c.offsets[u + 1] = (long long)c.targets.size();
+        }
+        return c;
+    }
+
+    // Snapshot straight from an edge list (counting sort by source; each list keeps input order).
+    // Undirected edges are stored in both directions, as UnifiedGraph does. `w` may be empty.
+    static CSRGraph fromEdges(int n, bool directed, bool weighted, const std::vector<int>& src,
+                              const std::vector<int>& dst, const std::vector<int>& w) {
+        CSRGraph c;
+        c.directed = directed;
+        c.weighted = weighted;
+        c.offsets.assign(n + 1, 0);
+        size_t m = src.size();
+        for (size_t i = 0; i < m; ++i) {
+            ++c.offsets[src[i] + 1];
+            if (!directed) ++c.offsets[dst[i] + 1];
+        }
+        for (int u = 0; u < n; ++u) c.offsets[u + 1] += c.offsets[u];
+        c.targets.resize(c.offsets[n]);
+        c.weights.resize(c.offsets[n]);
+        std::vector<long long> fill(c.offsets.begin(), c.offsets.end() - 1);
+        for (size_t i = 0; i < m; ++i) {
+            int weight = (weighted && !w.empty()) ? w[i] : 1;
+            long long k = fill[src[i]]++;
+            c.targets[k] = dst[i];
+            c.weights[k] = weight;
+            if (!directed) {
+                k = fill[dst[i]]++;
+                c.targets[k] = src[i];
+                c.weights[k] = weight;
+            }
+        }
+        return c;
+    }
+
+    // Canonical undirected view: arcs and their reverses merged into sorted, unique, loop-free lists.
+    // Lets structural passes (ordering, communities) treat directed graphs by their topology.
+    CSRGraph symmetrize() const {
+        CSRGraph both = *this;
+        if (directed) {
+            CSRGraph t = transpose();
+            int n = vertexCount();
+            both.offsets.assign(n + 1, 0);
+            both.targets.clear();
+            both.weights.clear();
+            for (int u = 0; u < n; ++u) {
+                both.targets.insert(both.targets.end(), neighborsBegin(u), neighborsEnd(u));
+                both.targets.insert(both.targets.end(), t.neighborsBegin(u), t.neighborsEnd(u));
+                both.weights.insert(both.weights.end(), weightsBegin(u), weightsBegin(u) + degree(u));
+                both.weights.insert(both.weights.end(), t.weightsBegin(u), t.weightsBegin(u) + t.degree(u));
+                both.offsets[u + 1] = (long long)both.targets.size();
+            }
+        }
+        CSRGraph c;
+        int n = both.vertexCount();
+        c.directed = false;
+        c.weighted = weighted;
+        c.sorted = true;
+        c.offsets.assign(n + 1, 0);
+        std::vector<std::pair<int, int>> row;
+        for (int u = 0; u < n; ++u) {
+            row.clear();
+            for (long long k = both.offsets[u]; k < both.offsets[u + 1]; ++k)
+                if (both.targets[k] != u) row.emplace_back(both.targets[k], both.weights[k]);
+            std::sort(row.begin(), row.end());
+            for (size_t i = 0; i < row.size(); ++i) {
+                if (i > 0 && row[i].first == row[i - 1].first) continue;
+                c.targets.push_back(row[i].first);
+                c.weights.push_back(row[i].second);
+            }
+            c.offsets[u + 1] = (long long)c.targets.size();
+        }
+        return c;
+    }
+
+    // Same graph with every arc reversed (in-neighbour lists), used by pull-style kernels
+    CSRGraph transpose() const {
+        CSRGraph t;
+        int n = vertexCount();
+        t.directed = directed;
+        t.weighted = weighted;
+        t.sorted = sorted; // sources are visited in increasing order
+        t.offsets.assign(n + 1, 0);
+        for (int v : targets) ++t.offsets[v + 1];
+        for (int u = 0; u < n; ++u) t.offsets[u + 1] += t.offsets[u];
+        t.targets.resize(targets.size());
+        t.weights.resize(weights.size());
+        std::vector<long long> fill(t.offsets.begin(), t.offsets.end() - 1);
+        for (int u = 0; u < n; ++u) {
+            for (long long k = offsets[u]; k < offsets[u + 1]; ++k) {
+                long long slot = fill[targets[k]]++;
+                t.targets[slot] = u;
+                t.weights[slot] = weights[k];
+            }
+        }
+        return t;
+    }
+
+    int vertexCount() const { return offsets.empty() ? 0 : (int)offsets.size() - 1; }
+    long long arcCount() const { return (long long)targets.size(); }
+    int degree(int u) const { return (int)(offsets[u + 1] - offsets[u]); }
+
+    const int* neighborsBegin(int u) const { return targets.data() + offsets[u]; }
+    const int* neighborsEnd(int u) const { return targets.data() + offsets[u + 1]; }
+    const int* weightsBegin(int u) const { return weights.data() + offsets[u]; }
+
+    bool isDirected() const { return directed; }
+    bool isWeighted() const { return weighted; }
+    // True for freezeCanonical() snapshots: lists are sorted, unique and loop-free
+    bool isSorted() const { return sorted; }
+
+    std::vector<long long> offsets;
+    std::vector<int> targets;
+    std::vector<int> weights;
+
+private:
+    bool directed{true};
+    bool weighted{false};
+    bool sorted{false};
+};
+
+#endif // CSR_GRAPH_H
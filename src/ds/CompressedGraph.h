@@ -0,0 +1,286 @@
+#ifndef COMPRESSED_GRAPH_H
+#define COMPRESSED_GRAPH_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "UnifiedGraph.h"
+#include "Traversal.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+// Read-only, gap-encoded adjacency in Stream VByte format.
+// Each neighbour list is sorted and stored as gaps; the first entry is relative to u itself, so
+// graphs with local numbering (see GraphReordering) stay small there too. Every group of four
+// gaps has one control byte (2 bits per value = byte length - 1) followed by 1-4 data bytes per
+// value, so small gaps cost one byte instead of UnifiedGraph::Edge's eight. Weights of weighted
+// graphs go to a second stream in the same order, zigzag-encoded so negatives stay small.
+// With SSSE3 a whole group is decoded by one shuffle; other targets use the scalar decoder.
+class CompressedGraph {
+public:
+    struct MemoryReport {
+        long long vertices{0}, arcs{0};
+        long long adjacencyListBytes{0}; // vector<vector<Edge>> as held by UnifiedGraph
+        long long csrBytes{0};           // flat offsets + targets + weights
+        long long compressedBytes{0};    // this format
+
+        double ratio() const { return compressedBytes ? (double)adjacencyListBytes / compressedBytes : 0.0; }
+    };
+
+    CompressedGraph() = default;
+
+    static CompressedGraph build(const UnifiedGraph& g) {
+        CompressedGraph c;
+        int n = g.vertexCount();
+        c.directed = g.isDirected();
+        c.weighted = g.isWeighted();
+        c.degrees.resize(n);
+        c.alive.resize(n);
+        c.offsets.assign(n + 1, 0);
+        if (c.weighted) c.weightOffsets.assign(n + 1, 0);
+
+        std::vector<std::pair<int, int>> row;
+        std::vector<uint32_t> values;
+        for (int u = 0; u < n; ++u) {
+            c.alive[u] = g.isAlive(u);
+            row.clear();
+            for (const auto& e : g.neighbors(u)) row.emplace_back(e.to, e.weight);
+            std::sort(row.begin(), row.end());
+            c.degrees[u] = (int)row.size();
+
+            values.clear();
+            for (size_t i = 0; i < row.size(); ++i)
+                values.push_back(i == 0 ? zigzag(row[0].first - u) : (uint32_t)(row[i].first - row[i - 1].first));
+            encode(values, c.bytes);
+            c.offsets[u + 1] = (long long)c.bytes.size();
+
+            if (c.weighted) {
+                values.clear();
+                for (const auto& [to, w] : row) values.push_back(zigzag(w));
+                encode(values, c.weightBytes);
+                c.weightOffsets[u + 1] = (long long)c.weightBytes.size();
+            }
+        }
+        // The SIMD decoder loads 16 bytes at a time; keep that in bounds for the last group
+        c.bytes.resize(c.bytes.size() + 16, 0);
+        if (c.weighted) c.weightBytes.resize(c.weightBytes.size() + 16, 0);
+        return c;
+    }
+
+    int vertexCount() const { return (int)degrees.size(); }
+    bool isAlive(int u) const { return u >= 0 && u < (int)degrees.size() && alive[u]; }
+    int degree(int u) const { return degrees[u]; }
+    long long arcCount() const {
+        long long m = 0;
+        for (int d : degrees) m += d;
+        return m;
+    }
+    bool isDirected() const { return directed; }
+    bool isWeighted() const { return weighted; }
+
+    // Decodes u's neighbours (ascending) into out, which needs room for degree(u) + 3 entries
+    int decodeNeighbors(int u, int* out) const {
+        int d = degrees[u];
+        decode(bytes.data() + offsets[u], d, reinterpret_cast<uint32_t*>(out));
+        if (d > 0) out[0] = u + unzigzag((uint32_t)out[0]);
+        prefixSum(reinterpret_cast<uint32_t*>(out), d);
+        return d;
+    }
+
+    // Same contract for weights; unweighted graphs report 1 per arc
+    int decodeWeights(int u, int* out) const {
+        int d = degrees[u];
+        if (!weighted) {
+            std::fill(out, out + d, 1);
+            return d;
+        }
+        uint32_t* raw = reinterpret_cast<uint32_t*>(out);
+        decode(weightBytes.data() + weightOffsets[u], d, raw);
+        for (int i = 0; i < d; ++i) out[i] = unzigzag(raw[i]);
+        return d;
+    }
+
+    // Calls fn(v, weight) for each arc u -> v, decoding one group of four at a time
+    template <class F>
+    void forEachNeighbor(int u, F&& fn) const {
+        int d = degrees[u];
+        const uint8_t* ctrl = bytes.data() + offsets[u];
+        const uint8_t* data = ctrl + (d + 3) / 4;
+        const uint8_t* wctrl = weighted ? weightBytes.data() + weightOffsets[u] : nullptr;
+        const uint8_t* wdata = weighted ? wctrl + (d + 3) / 4 : nullptr;
+        uint32_t gaps[4], ws[4] = {1, 1, 1, 1};
+        int prev = u;
+        for (int i = 0; i < d; i += 4) {
+            int k = std::min(4, d - i);
+            data = decodeGroup(ctrl[i / 4], data, k, gaps);
+            if (weighted) wdata = decodeGroup(wctrl[i / 4], wdata, k, ws);
+            for (int j = 0; j < k; ++j) {
+                prev += (i + j == 0) ? unzigzag(gaps[0]) : (int)gaps[j];
+                int w = weighted ? unzigzag(ws[j]) : 1;
+                fn(prev, w);
+            }
+        }
+    }
+
+    // Same visiting rules as UnifiedGraph::bfs/dfs (a removed start yields nothing), with
+    // neighbours taken in ascending ID order
+    BfsCursor<CompressedGraph> bfsCursor(int start) const { return BfsCursor<CompressedGraph>(*this, isAlive(start) ? start : -1); }
+    BfsCursor<CompressedGraph> bfsCursor(int start, TraversalWorkspace& ws) const { return BfsCursor<CompressedGraph>(*this, isAlive(start) ? start : -1, ws); }
+    DfsCursor<CompressedGraph> dfsCursor(int start) const { return DfsCursor<CompressedGraph>(*this, isAlive(start) ? start : -1); }
+    DfsCursor<CompressedGraph> dfsCursor(int start, TraversalWorkspace& ws) const { return DfsCursor<CompressedGraph>(*this, isAlive(start) ? start : -1, ws); }
+
+    std::vector<int> bfs(int start) const {
+        std::vector<int> order;
+        TraversalStep s;
+        for (auto c = bfsCursor(start); c.next(s);) order.push_back(s.vertex);
+        return order;
+    }
+
+    std::vector<int> dfs(int start) const {
+        std::vector<int> order;
+        TraversalStep s;
+        for (auto c = dfsCursor(start); c.next(s);) order.push_back(s.vertex);
+        return order;
+    }
+
+    // Cursor access: decodes straight from the byte stream, one group of four at a time
+    template <class F>
+    friend void traversalNeighbors(const CompressedGraph& g, int u, F&& fn) {
+        g.forEachNeighbor(u, [&](int v, int) { fn(v); });
+    }
+
+    // DFS frames resume mid-list, so gaps are decoded one at a time from the stored byte offset
+    friend bool traversalNextNeighbor(const CompressedGraph& g, int u, NeighborPosition& pos, int& v) {
+        int d = g.degrees[u];
+        if (pos.index >= d) return false;
+        const uint8_t* ctrl = g.bytes.data() + g.offsets[u];
+        if (pos.index == 0) {
+            pos.offset = (d + 3) / 4;
+            pos.last = u;
+        }
+        int len = ((ctrl[pos.index / 4] >> (2 * (pos.index % 4))) & 3) + 1;
+        uint32_t gap = 0;
+        for (int b = 0; b < len; ++b) gap |= (uint32_t)ctrl[pos.offset + b] << (8 * b);
+        pos.offset += len;
+        pos.last += pos.index == 0 ? unzigzag(gap) : (int)gap;
+        ++pos.index;
+        v = pos.last;
+        return true;
+    }
+
+    long long memoryBytes() const {
+        return (long long)(bytes.capacity() + weightBytes.capacity()) +
+               (long long)(offsets.capacity() + weightOffsets.capacity()) * (long long)sizeof(long long) +
+               (long long)degrees.capacity() * (long long)sizeof(int) + (long long)alive.capacity();
+    }
+
+    static MemoryReport compare(const UnifiedGraph& g, const CompressedGraph& c) {
+        MemoryReport r;
+        r.vertices = g.vertexCount();
+        r.arcs = g.arcCount();
+        r.adjacencyListBytes = r.vertices * (long long)sizeof(std::vector<UnifiedGraph::Edge>);
+        for (int u = 0; u < g.vertexCount(); ++u)
+            r.adjacencyListBytes += (long long)g.neighbors(u).capacity() * (long long)sizeof(UnifiedGraph::Edge);
+        r.csrBytes = (r.vertices + 1) * (long long)sizeof(long long) + r.arcs * (long long)sizeof(int) * (g.isWeighted() ? 2 : 1);
+        r.compressedBytes = c.memoryBytes();
+        return r;
+    }
+
+private:
+    static uint32_t zigzag(int v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+    static int unzigzag(uint32_t v) { return (int)(v >> 1) ^ -(int)(v & 1); }
+
+    static int byteLength(uint32_t v) { return v < (1u << 8) ? 1 : v < (1u << 16) ? 2 : v < (1u << 24) ? 3 : 4; }
+
+    // Appends control bytes for all values, then their data bytes
+    static void encode(const std::vector<uint32_t>& values, std::vector<uint8_t>& out) {
+        size_t ctrlAt = out.size();
+        size_t groups = (values.size() + 3) / 4;
+        out.resize(out.size() + groups, 0);
+        for (size_t i = 0; i < values.size(); ++i) {
+            int len = byteLength(values[i]);
+            out[ctrlAt + i / 4] |= (uint8_t)((len - 1) << ((i % 4) * 2));
+            for (int b = 0; b < len; ++b) out.push_back((uint8_t)(values[i] >> (8 * b)));
+        }
+    }
+
+    static void decode(const uint8_t* ctrl, int count, uint32_t* out) {
+        const uint8_t* data = ctrl + (count + 3) / 4;
+        for (int i = 0; i < count; i += 4) data = decodeGroup(ctrl[i / 4], data, std::min(4, count - i), out + i);
+    }
+
+    // Decodes `count` (1-4) values of one group, returns the next data pointer
+    static const uint8_t* decodeGroup(uint8_t control, const uint8_t* data, int count, uint32_t* out) {
+#if defined(__SSSE3__)
+        if (count == 4) {
+            const Tables& t = tables();
+            __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            __m128i shuffled = _mm_shuffle_epi8(raw, _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.shuffle[control])));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), shuffled);
+            return data + t.length[control];
+        }
+#endif
+        for (int j = 0; j < count; ++j) {
+            int len = ((control >> (2 * j)) & 3) + 1;
+            uint32_t v = 0;
+            for (int b = 0; b < len; ++b) v |= (uint32_t)data[b] << (8 * b);
+            out[j] = v;
+            data += len;
+        }
+        return data;
+    }
+
+    // Gaps -> absolute IDs (v[0] already holds the first ID)
+    static void prefixSum(uint32_t* v, int count) {
+        uint32_t prev = 0;
+        int i = 0;
+#if defined(__SSSE3__)
+        __m128i carry = _mm_setzero_si128();
+        for (; i + 4 <= count; i += 4) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(v + i));
+            x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+            x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+            x = _mm_add_epi32(x, carry);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(v + i), x);
+            carry = _mm_shuffle_epi32(x, 0xFF);
+        }
+        if (i > 0) prev = v[i - 1];
+#endif
+        for (; i < count; ++i) { prev += v[i]; v[i] = prev; }
+    }
+
+#if defined(__SSSE3__)
+    struct Tables {
+        alignas(16) uint8_t shuffle[256][16];
+        uint8_t length[256];
+        Tables() {
+            for (int c = 0; c < 256; ++c) {
+                int pos = 0;
+                for (int j = 0; j < 4; ++j) {
+                    int len = ((c >> (2 * j)) & 3) + 1;
+                    for (int b = 0; b < 4; ++b) shuffle[c][4 * j + b] = b < len ? (uint8_t)(pos + b) : 0xFF;
+                    pos += len;
+                }
+                length[c] = (uint8_t)pos;
+            }
+        }
+    };
+    static const Tables& tables() {
+        static const Tables t;
+        return t;
+    }
+#endif
+
+    bool directed{true};
+    bool weighted{false};
+    std::vector<int> degrees;
+    std::vector<char> alive;              // copied from the source graph; removed vertices keep their ID
+    std::vector<long long> offsets;       // start of each vertex's control bytes in `bytes`
+    std::vector<uint8_t> bytes;
+    std::vector<long long> weightOffsets;
+    std::vector<uint8_t> weightBytes;
+};
+
+#endif // COMPRESSED_GRAPH_H
@@ -2,8 +2,8 @@
 #define DIRECTED_UNWEIGHTED_GRAPH_H
 
 #include <vector>
-#include <queue>
-#include <stack>
+#include <algorithm>
+#include "Traversal.h"
 
 // Simple directed, unweighted graph using adjacency lists
 class DirectedUnweightedGraph {
@@ -12,46 +12,74 @@ public:
 
     int addVertex() {
         adj.emplace_back();
+        alive.push_back(1);
         return n++;
     }
 
     void addEdge(int u, int v) {
         ensureVertex(std::max(u, v));
+        if (!alive[u] || !alive[v]) return;
         adj[u].push_back(v);
     }
 
+    // Removes one u -> v arc in O(deg(u)), keeping the order of the rest
+    bool removeEdge(int u, int v) {
+        if (u < 0 || u >= n) return false;
+        auto it = std::find(adj[u].begin(), adj[u].end(), v);
+        if (it == adj[u].end()) return false;
+        adj[u].erase(it);
+        return true;
+    }
+
+    // Tombstones u (its ID stays reserved until compact()); incoming arcs need one O(V + E) sweep
+    bool removeVertex(int u) {
+        if (!isAlive(u)) return false;
+        for (auto& list : adj) list.erase(std::remove(list.begin(), list.end(), u), list.end());
+        std::vector<int>().swap(adj[u]);
+        alive[u] = 0;
+        return true;
+    }
+
+    bool isAlive(int u) const { return u >= 0 && u < n && alive[u]; }
+
+    // Renumbers surviving vertices densely in their original order; returns newId[old] (-1 if removed)
+    std::vector<int> compact() {
+        std::vector<int> newId(n, -1);
+        int next = 0;
+        for (int v = 0; v < n; ++v) if (alive[v]) newId[v] = next++;
+        for (int v = 0; v < n; ++v) {
+            if (newId[v] < 0) continue;
+            for (int& x : adj[v]) x = newId[x];
+            if (newId[v] != v) adj[newId[v]].swap(adj[v]);
+        }
+        adj.resize(next);
+        alive.assign(next, 1);
+        n = next;
+        return newId;
+    }
+
     int vertexCount() const { return n; }
 
     const std::vector<int>& neighbors(int u) const { return adj[u]; }
 
+    // Pull-based traversals (see Traversal.h): one visit per next(), so callers can stop early.
+    // A dead start yields nothing.
+    BfsCursor<DirectedUnweightedGraph> bfsCursor(int start) const { return BfsCursor<DirectedUnweightedGraph>(*this, isAlive(start) ? start : -1); }
+    BfsCursor<DirectedUnweightedGraph> bfsCursor(int start, TraversalWorkspace& ws) const { return BfsCursor<DirectedUnweightedGraph>(*this, isAlive(start) ? start : -1, ws); }
+    DfsCursor<DirectedUnweightedGraph> dfsCursor(int start) const { return DfsCursor<DirectedUnweightedGraph>(*this, isAlive(start) ? start : -1); }
+    DfsCursor<DirectedUnweightedGraph> dfsCursor(int start, TraversalWorkspace& ws) const { return DfsCursor<DirectedUnweightedGraph>(*this, isAlive(start) ? start : -1, ws); }
+
     std::vector<int> bfs(int start) const {
         std::vector<int> order;
-        if (start < 0 || start >= n) return order;
-        std::vector<bool> vis(n, false);
-        std::queue<int> q; q.push(start); vis[start] = true;
-        while (!q.empty()) {
-            int u = q.front(); q.pop();
-            order.push_back(u);
-            for (int v : adj[u]) if (!vis[v]) { vis[v] = true; q.push(v); }
-        }
+        TraversalStep s;
+        for (auto c = bfsCursor(start); c.next(s);) order.push_back(s.vertex);
         return order;
     }
 
     std::vector<int> dfs(int start) const {
         std::vector<int> order;
-        if (start < 0 || start >= n) return order;
-        std::vector<bool> vis(n, false);
-        std::stack<int> st; st.push(start);
-        while (!st.empty()) {
-            int u = st.top(); st.pop();
-            if (vis[u]) continue;
-            vis[u] = true; order.push_back(u);
-            // push neighbors in reverse to get natural order
-            for (int i = (int)adj[u].size() - 1; i >= 0; --i) {
-                int v = adj[u][i];
-                if (!vis[v]) st.push(v);
-            }
-        }
+        TraversalStep s;
+        for (auto c = dfsCursor(start); c.next(s);) order.push_back(s.vertex);
         return order;
     }
 
@@ -62,6 +90,7 @@ private:
 
     int n;
     std::vector<std::vector<int>> adj;
+    std::vector<char> alive;
 };
 
 #endif // DIRECTED_UNWEIGHTED_GRAPH_H
@@ -2,9 +2,9 @@
 #define DIRECTED_WEIGHTED_GRAPH_H
 
 #include <vector>
-#include <queue>
-#include <stack>
 #include <utility>
+#include <algorithm>
+#include "Traversal.h"
 
 // Simple directed, weighted graph using adjacency lists
 class DirectedWeightedGraph {
@@ -15,36 +15,72 @@ public:
 
     int addVertex() {
         adj.emplace_back();
+        alive.push_back(1);
         return n++;
     }
 
     void addEdge(int u, int v, int w) {
         ensureVertex(std::max(u, v));
+        if (!alive[u] || !alive[v]) return;
         adj[u].emplace_back(v, w);
     }
 
+    // Removes one u -> v arc in O(deg(u)), keeping the order of the rest
+    bool removeEdge(int u, int v) {
+        if (u < 0 || u >= n) return false;
+        auto it = std::find_if(adj[u].begin(), adj[u].end(), [v](const Edge& e){ return e.first == v; });
+        if (it == adj[u].end()) return false;
+        adj[u].erase(it);
+        return true;
+    }
+
+    // Tombstones u (its ID stays reserved until compact()); incoming arcs need one O(V + E) sweep
+    bool removeVertex(int u) {
+        if (!isAlive(u)) return false;
+        for (auto& list : adj)
+            list.erase(std::remove_if(list.begin(), list.end(), [u](const Edge& e){ return e.first == u; }), list.end());
+        std::vector<Edge>().swap(adj[u]);
+        alive[u] = 0;
+        return true;
+    }
+
+    bool isAlive(int u) const { return u >= 0 && u < n && alive[u]; }
+
+    // Renumbers surviving vertices densely in their original order; returns newId[old] (-1 if removed)
+    std::vector<int> compact() {
+        std::vector<int> newId(n, -1);
+        int next = 0;
+        for (int v = 0; v < n; ++v) if (alive[v]) newId[v] = next++;
+        for (int v = 0; v < n; ++v) {
+            if (newId[v] < 0) continue;
+            for (auto& e : adj[v]) e.first = newId[e.first];
+            if (newId[v] != v) adj[newId[v]].swap(adj[v]);
+        }
+        adj.resize(next);
+        alive.assign(next, 1);
+        n = next;
+        return newId;
+    }
+
     int vertexCount() const { return n; }
 
     const std::vector<Edge>& neighbors(int u) const { return adj[u]; }
 
     // BFS and DFS by topology (ignores weights for traversal order)
+    BfsCursor<DirectedWeightedGraph> bfsCursor(int start) const { return BfsCursor<DirectedWeightedGraph>(*this, isAlive(start)?start:-1); }
+    BfsCursor<DirectedWeightedGraph> bfsCursor(int start, TraversalWorkspace& ws) const { return BfsCursor<DirectedWeightedGraph>(*this, isAlive(start)?start:-1, ws); }
+    DfsCursor<DirectedWeightedGraph> dfsCursor(int start) const { return DfsCursor<DirectedWeightedGraph>(*this, isAlive(start)?start:-1); }
+    DfsCursor<DirectedWeightedGraph> dfsCursor(int start, TraversalWorkspace& ws) const { return DfsCursor<DirectedWeightedGraph>(*this, isAlive(start)?start:-1, ws); }
+
     std::vector<int> bfs(int start) const {
-        std::vector<int> order; if (start < 0 || start >= n) return order;
-        std::vector<bool> vis(n,false); std::queue<int> q; q.push(start); vis[start]=true;
-        while(!q.empty()){
-            int u=q.front(); q.pop(); order.push_back(u);
-            for(const auto &e: adj[u]) if(!vis[e.first]){ vis[e.first]=true; q.push(e.first);}    
-        }
+        std::vector<int> order; TraversalStep s;
+        for(auto c=bfsCursor(start); c.next(s);) order.push_back(s.vertex);
         return order;
     }
 
     std::vector<int> dfs(int start) const {
-        std::vector<int> order; if (start < 0 || start >= n) return order;
-        std::vector<bool> vis(n,false); std::stack<int> st; st.push(start);
-        while(!st.empty()){
-            int u=st.top(); st.pop(); if(vis[u]) continue; vis[u]=true; order.push_back(u);
-            for(int i=(int)adj[u].size()-1;i>=0;--i){ int v=adj[u][i].first; if(!vis[v]) st.push(v);}    
-        }
+        std::vector<int> order; TraversalStep s;
+        for(auto c=dfsCursor(start); c.next(s);) order.push_back(s.vertex);
         return order;
     }
 
@@ -52,6 +88,7 @@ private:
     void ensureVertex(int idx){ while(idx>=n) addVertex(); }
     int n; 
     std::vector<std::vector<Edge>> adj;
+    std::vector<char> alive;
 };
 
 #endif // DIRECTED_WEIGHTED_GRAPH_H
@@ -0,0 +1,115 @@
+#ifndef EDGE_INDEX_H
+#define EDGE_INDEX_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Open-addressing hash of (u, v) pairs with a multiplicity per pair.
+// Linear probing over a power-of-two table kept at most 70% full; erasing uses backward-shift
+// deletion, so there are no tombstones and lookups never degrade after many removals.
+// Callers decide what a pair means (UnifiedGraph passes (min, max) for undirected edges).
+class EdgeIndex {
+public:
+    EdgeIndex() = default;
+
+    int count(int u, int v) const {
+        if (table.empty()) return 0;
+        uint64_t key = pack(u, v);
+        for (size_t i = hash(key) & mask;; i = (i + 1) & mask) {
+            if (table[i].key == key) return table[i].count;
+            if (table[i].key == EMPTY) return 0;
+        }
+    }
+
+    bool contains(int u, int v) const { return count(u, v) > 0; }
+
+    // Returns the pair's multiplicity after the insert
+    int add(int u, int v) {
+        if ((used + 1) * 10 > table.size() * 7) grow();
+        uint64_t key = pack(u, v);
+        size_t i = hash(key) & mask;
+        while (table[i].key != EMPTY && table[i].key != key) i = (i + 1) & mask;
+        if (table[i].key == EMPTY) {
+            table[i].key = key;
+            ++used;
+        }
+        return ++table[i].count;
+    }
+
+    // Drops one occurrence; returns the remaining multiplicity (0 if the pair was absent)
+    int remove(int u, int v) {
+        if (table.empty()) return 0;
+        uint64_t key = pack(u, v);
+        size_t i = hash(key) & mask;
+        while (table[i].key != key) {
+            if (table[i].key == EMPTY) return 0;
+            i = (i + 1) & mask;
+        }
+        if (--table[i].count > 0) return table[i].count;
+
+        // Backward shift: pull later entries of the probe run into the hole when that keeps
+        // them reachable from their home slot
+        size_t hole = i;
+        for (size_t j = (hole + 1) & mask; table[j].key != EMPTY; j = (j + 1) & mask) {
+            size_t home = hash(table[j].key) & mask;
+            if (((j - home) & mask) >= ((j - hole) & mask)) {
+                table[hole] = table[j];
+                hole = j;
+            }
+        }
+        table[hole] = Slot();
+        --used;
+        return 0;
+    }
+
+    // Distinct pairs
+    size_t size() const { return used; }
+
+    void clear() {
+        table.clear();
+        used = 0;
+        mask = 0;
+    }
+
+    size_t memoryBytes() const { return table.capacity() * sizeof(Slot); }
+
+private:
+    static constexpr uint64_t EMPTY = ~0ull;
+
+    struct Slot {
+        uint64_t key{EMPTY};
+        int count{0};
+    };
+
+    static uint64_t pack(int u, int v) { return ((uint64_t)(uint32_t)u << 32) | (uint32_t)v; }
+
+    // splitmix64 finalizer: consecutive IDs land far apart
+    static size_t hash(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        x ^= x >> 31;
+        return (size_t)x;
+    }
+
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(table);
+        table.assign(old.empty() ? 16 : old.size() * 2, Slot());
+        mask = table.size() - 1;
+        for (const Slot& s : old) {
+            if (s.key == EMPTY) continue;
+            size_t i = hash(s.key) & mask;
+            while (table[i].key != EMPTY) i = (i + 1) & mask;
+            table[i] = s;
+        }
+    }
+
+    std::vector<Slot> table;
+    size_t used{0};
+    size_t mask{0};
+};
+
+#endif // EDGE_INDEX_H
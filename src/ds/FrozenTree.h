@@ -0,0 +1,180 @@
+#ifndef FROZEN_TREE_H
+#define FROZEN_TREE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Tree.h"
+
+// Read-only snapshot of a BSTree's keys for lookup-heavy work. The keys sit in one int array in
+// an implicit perfectly balanced search tree, so there are no child links to chase and a search
+// touches far fewer cache lines than the arena tree:
+//
+//  - Eytzinger: breadth-first order (children of k at 2k and 2k + 1). The 16 descendants four
+//    levels below k share one 64-byte line, so contains() prefetches that line while it works
+//    through the next four levels.
+//  - van Emde Boas: the tree is cut at half its height and the top and each bottom subtree are
+//    laid out recursively, so every subtree of any height sits in a contiguous run. This is good
+//    for any cache line or page size without tuning; the price is padding up to 2^h - 1 keys.
+//
+// Both searches descend to a leaf using arithmetic in place of compare-and-branch, so the
+// timing does not depend on where the key is. The snapshot does not follow later changes to
+// the tree; freeze it again after updating.
+class FrozenTree {
+public:
+    enum class Layout { Eytzinger, VanEmdeBoas };
+
+    FrozenTree() = default;
+
+    static FrozenTree freeze(const BSTree& tree, Layout layout = Layout::Eytzinger) {
+        return fromSorted(tree.inorder(), layout);
+    }
+
+    // Keys must be sorted
+    static FrozenTree fromSorted(const std::vector<int>& sorted, Layout layout) {
+        FrozenTree f;
+        f.layout_ = layout;
+        f.count_ = sorted.size();
+        if (layout == Layout::Eytzinger) f.buildEytzinger(sorted);
+        else f.buildVanEmdeBoas(sorted);
+        return f;
+    }
+
+    bool contains(int v) const {
+        return layout_ == Layout::Eytzinger ? containsEytzinger(v) : containsVanEmdeBoas(v);
+    }
+
+    Layout layout() const { return layout_; }
+    size_t size() const { return count_; }
+    size_t memoryBytes() const { return keys_.capacity() * sizeof(int) + (top_.capacity() * 3) * sizeof(uint32_t); }
+
+private:
+    Layout layout_{Layout::Eytzinger};
+    size_t count_{0};
+    std::vector<int> keys_;
+    size_t base_{0};   // Eytzinger: keys_[base_ + k] is node k (1-based), with keys_[base_] on a line boundary
+    int height_{0};    // van Emde Boas: levels of the padded tree
+    // van Emde Boas, per depth d >= 1: the tree that has a bottom subtree rooted at depth d has
+    // its root at depth ancestor_[d], a top part of top_[d] nodes and bottom subtrees of
+    // bottom_[d] nodes each
+    std::vector<uint32_t> top_, bottom_, ancestor_;
+
+    static void prefetch(const int* base, size_t k) {
+#if defined(__GNUC__)
+        // Address arithmetic on integers: the prefetch may point past the array
+        __builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<uintptr_t>(base) + 64 * k));
+#else
+        (void)base; (void)k;
+#endif
+    }
+
+    static int trailingOnes(size_t k) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(~(unsigned long long)k);
+#else
+        int c = 0;
+        while (k & 1) { k >>= 1; ++c; }
+        return c;
+#endif
+    }
+
+    // Fills node k, k = 1..n, with the in-order walk of the implicit tree, which visits the sorted
+    // keys in order. The walk steps node to node (no recursion) in O(n) total.
+    void buildEytzinger(const std::vector<int>& sorted) {
+        size_t n = count_;
+        keys_.assign(n + 1 + 16, 0);
+        uintptr_t address = reinterpret_cast<uintptr_t>(keys_.data());
+        base_ = ((64 - address % 64) % 64) / sizeof(int);
+        if (n == 0) return;
+        int* b = keys_.data() + base_;
+        size_t k = 1;
+        while (2 * k <= n) k *= 2;
+        for (size_t i = 0; i < n; ++i) {
+            b[k] = sorted[i];
+            if (2 * k + 1 <= n) {
+                k = 2 * k + 1;
+                while (2 * k <= n) k *= 2;
+            } else {
+                while (k & 1) k >>= 1;
+                k >>= 1;
+            }
+        }
+    }
+
+    // Descends to a leaf going right past smaller keys. The final k is a node's right-then-left
+    // path plus trailing right turns; stripping those recovers the smallest key >= v (k = 0 when
+    // there is none).
+    bool containsEytzinger(int v) const {
+        const int* b = keys_.data() + base_;
+        size_t k = 1;
+        while (k <= count_) {
+            prefetch(b, 16 * k);
+            k = 2 * k + (b[k] < v);
+        }
+        k >>= trailingOnes(k) + 1;
+        return k != 0 && b[k] == v;
+    }
+
+    void buildVanEmdeBoas(const std::vector<int>& sorted) {
+        size_t n = count_;
+        if (n == 0) return;
+        height_ = 1;
+        while (((size_t(1) << height_) - 1) < n) ++height_;
+        size_t padded = (size_t(1) << height_) - 1;
+
+        // Cut (depth, height) into a top of height h/2 and bottoms of the rest, down to single levels
+        top_.assign(height_, 0);
+        bottom_.assign(height_, 0);
+        ancestor_.assign(height_, 0);
+        std::vector<std::pair<int, int>> pending{{0, height_}};
+        while (!pending.empty()) {
+            auto [depth, h] = pending.back();
+            pending.pop_back();
+            if (h == 1) continue;
+            int t = h / 2, rest = h - t;
+            top_[depth + t] = (uint32_t(1) << t) - 1;
+            bottom_[depth + t] = (uint32_t(1) << rest) - 1;
+            ancestor_[depth + t] = (uint32_t)depth;
+            pending.push_back({depth, t});
+            pending.push_back({depth + t, rest});
+        }
+
+        // Breadth-first first (padding repeats the largest key, which keeps the order), then move
+        // each node to its van Emde Boas slot, found from its ancestor's slot
+        std::vector<int> full(sorted);
+        full.resize(padded, sorted.back());
+        FrozenTree bfs = fromSorted(full, Layout::Eytzinger);
+        full = std::vector<int>();
+        const int* b = bfs.keys_.data() + bfs.base_;
+        std::vector<uint32_t> slot(padded + 1);
+        keys_.resize(padded);
+        slot[1] = 0;
+        keys_[0] = b[1];
+        for (int d = 1; d < height_; ++d) {
+            size_t first = size_t(1) << d;
+            int up = d - (int)ancestor_[d];
+            for (size_t i = first; i < 2 * first; ++i) {
+                slot[i] = slot[i >> up] + top_[d] + (uint32_t)(i & top_[d]) * bottom_[d];
+                keys_[slot[i]] = b[i];
+            }
+        }
+    }
+
+    bool containsVanEmdeBoas(int v) const {
+        if (height_ == 0) return false;
+        uint32_t slot[32];
+        const int* keys = keys_.data();
+        size_t i = 1;
+        bool found = false;
+        slot[0] = 0;
+        for (int d = 0; d < height_; ++d) {
+            if (d > 0) slot[d] = slot[ancestor_[d]] + top_[d] + (uint32_t)(i & top_[d]) * bottom_[d];
+            int key = keys[slot[d]];
+            found |= key == v;
+            i = 2 * i + (key < v);
+        }
+        return found;
+    }
+};
+
+#endif // FROZEN_TREE_H
@@ -0,0 +1,415 @@
+#ifndef PERSISTENT_TREE_H
+#define PERSISTENT_TREE_H
+
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <limits>
+#include "Tree.h"
+#include "TreeBalancing.h"
+
+// Fully persistent BSTree: every insert, remove, build or clear leaves the previous tree intact
+// and adds a new version, so undo, redo and jumping to any version are O(1) (the current version
+// is just a different root). Versions share structure: an update copies only the nodes on the
+// path it walks, plus the few that rotations and colour flips touch, and links the copies to the
+// untouched subtrees of the version before. Under AVL or red-black balancing that is O(log n)
+// new nodes per version; a plain BST copies its search path, as long as the tree is deep.
+//
+// Nodes are immutable once their version is published. Within one operation, nodes allocated by
+// that operation are still private to it and are changed in place, so a rotation right after a
+// copy does not copy again, and a rebuild of n keys costs n nodes, not n paths.
+//
+// Balancing runs the same TreeBalancing rules as BSTree (AVL, left-leaning red-black insert and
+// top-down delete, bulk build), so a version has the shape the mutable tree would have, and
+// lastRotations() reports the rotations of the operation that made the current version. There
+// are no parent links, as a shared node has a parent in every version that contains it; updates
+// keep their path on an explicit stack instead, so nothing recurses.
+//
+// Making a new version while an older one is current drops the versions after it (like redo after
+// an edit). Their nodes, and those of old versions, are reclaimed by a copying collection: once the
+// arena has doubled since the last one, the nodes still reachable are moved into a new, compact
+// arena (node indices change). The history is capped at HISTORY_TREES times the largest tree it
+// holds, so the oldest versions are dropped when, say, repeated rebalances of a big tree each add
+// a full copy. Collection costs linear time in the nodes kept, amortised over as many allocations.
+class PersistentTree {
+public:
+    static constexpr int NIL = BSTree::NIL;
+    using Balance = BSTree::Balance;
+    using Rotation = BSTree::Rotation;
+
+    static constexpr int HISTORY_TREES = 4;
+    static constexpr int MIN_COLLECT_SLOTS = 1 << 16; // arena size below which nothing is collected
+
+    struct Node {
+        int value;
+        int left;
+        int right;
+        int height; // leaf = 0
+        int size;   // nodes in this subtree
+        bool red;   // red-black only: colour of the link from the parent
+    };
+
+    explicit PersistentTree(Balance balance = Balance::None) { reset(balance); }
+
+    // Drops every version and node; version 0 is an empty tree
+    void reset(Balance balance = Balance::None) {
+        nodes_.clear();
+        versions_.assign(1, {NIL, balance});
+        rotations_.clear();
+        current_ = 0;
+        dropped_ = 0;
+        collectAt_ = MIN_COLLECT_SLOTS;
+    }
+
+    // History. version() and checkout() count from the oldest version kept; droppedVersions() is
+    // how many older ones the cap let go of since reset().
+    int version() const { return current_; }
+    int droppedVersions() const { return dropped_; }
+    int versionCount() const { return (int)versions_.size(); }
+    bool canUndo() const { return current_ > 0; }
+    bool canRedo() const { return current_ + 1 < (int)versions_.size(); }
+    bool undo() { if (!canUndo()) return false; checkout(current_ - 1); return true; }
+    bool redo() { if (!canRedo()) return false; checkout(current_ + 1); return true; }
+    void checkout(int version) {
+        current_ = std::clamp(version, 0, (int)versions_.size() - 1);
+        rotations_.clear();
+    }
+
+    Balance balance() const { return versions_[current_].balance; }
+
+    // Updates; each one that changes the tree publishes a new version
+
+    bool insert(int v) {
+        rotations_.clear();
+        std::vector<Step> path;
+        int cur = root();
+        while (cur != NIL) {
+            if (v == nodes_[cur].value) return false; // no duplicates
+            path.push_back({cur, v < nodes_[cur].value});
+            cur = path.back().left ? nodes_[cur].left : nodes_[cur].right;
+        }
+        begin();
+        int top = rebuildPath(path, allocate(v));
+        if (working_ == Balance::RedBlack) nodes_[top].red = false; // top is this operation's copy
+        publish(top, balance());
+        return true;
+    }
+
+    bool remove(int v) {
+        rotations_.clear();
+        if (!contains(v)) return false;
+        begin();
+        int top = balance() == Balance::RedBlack ? TreeBalancing::removeRedBlack(*this, own(root()), v) : removeUnbalanced(v);
+        publish(top, balance());
+        return true;
+    }
+
+    // Empty tree as a new version
+    void clear() {
+        if (root() == NIL) return;
+        begin();
+        publish(NIL, balance());
+    }
+
+    // New version holding `values` (any order, duplicates dropped), linked as BSTree::buildSorted
+    // would. Returns the number of keys kept.
+    int build(std::vector<int> values) {
+        Parallel::sort(values);
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        begin();
+        nodes_.reserve(nodes_.size() + values.size());
+        publish(TreeBalancing::buildSorted(*this, values), balance());
+        return size();
+    }
+
+    // The current keys under another balancing, as a new version: inserted in preorder, which
+    // reproduces the same shape when switching back to a plain BST
+    void rebalance(Balance balance) {
+        std::vector<int> keys = preorder();
+        begin();
+        working_ = balance;
+        int top = NIL;
+        for (int v : keys) top = insertOwned(top, v);
+        rotations_.clear();
+        publish(top, balance);
+    }
+
+    const std::vector<Rotation>& lastRotations() const { return rotations_; }
+
+    // Reads, all on the current version
+
+    int root() const { return versions_[current_].root; }
+    const Node& node(int i) const { return nodes_[i]; }
+    // Arena slots over all versions: every node index is below this
+    int slotCount() const { return (int)nodes_.size(); }
+
+    int size() const { return sizeOf(root()); }
+    int height() const { return heightOf(root()); }
+
+    bool contains(int v) const {
+        int cur = root();
+        while (cur != NIL) {
+            const Node& n = nodes_[cur];
+            if (v == n.value) return true;
+            cur = v < n.value ? n.left : n.right;
+        }
+        return false;
+    }
+
+    // k-th smallest key, 0-based; INT_MIN when k is out of range. path, if given, receives the
+    // keys visited on the way down.
+    int select(int k, std::vector<int>* path = nullptr) const {
+        if (path) path->clear();
+        if (k < 0 || k >= size()) return std::numeric_limits<int>::min();
+        int n = root();
+        for (;;) {
+            if (path) path->push_back(nodes_[n].value);
+            int leftSize = sizeOf(nodes_[n].left);
+            if (k == leftSize) return nodes_[n].value;
+            if (k < leftSize) n = nodes_[n].left;
+            else { k -= leftSize + 1; n = nodes_[n].right; }
+        }
+    }
+
+    // Number of keys smaller than v (v itself need not be present)
+    int rank(int v, std::vector<int>* path = nullptr) const {
+        if (path) path->clear();
+        int r = 0, n = root();
+        while (n != NIL) {
+            if (path) path->push_back(nodes_[n].value);
+            if (v < nodes_[n].value) n = nodes_[n].left;
+            else if (v == nodes_[n].value) return r + sizeOf(nodes_[n].left);
+            else { r += sizeOf(nodes_[n].left) + 1; n = nodes_[n].right; }
+        }
+        return r;
+    }
+
+    int min() const {
+        int n = root();
+        if (n == NIL) return std::numeric_limits<int>::min();
+        while (nodes_[n].left != NIL) n = nodes_[n].left;
+        return nodes_[n].value;
+    }
+    int max() const {
+        int n = root();
+        if (n == NIL) return std::numeric_limits<int>::max();
+        while (nodes_[n].right != NIL) n = nodes_[n].right;
+        return nodes_[n].value;
+    }
+
+    // Traversals keep their own stack, as there are no parent links to climb
+    std::vector<int> inorder() const {
+        std::vector<int> out; out.reserve(size());
+        std::vector<int> stack;
+        for (int n = root(); n != NIL || !stack.empty();) {
+            if (n != NIL) { stack.push_back(n); n = nodes_[n].left; continue; }
+            n = stack.back(); stack.pop_back();
+            out.push_back(nodes_[n].value);
+            n = nodes_[n].right;
+        }
+        return out;
+    }
+    std::vector<int> preorder() const {
+        std::vector<int> out; out.reserve(size());
+        std::vector<int> stack;
+        if (root() != NIL) stack.push_back(root());
+        while (!stack.empty()) {
+            const Node& n = nodes_[stack.back()]; stack.pop_back();
+            out.push_back(n.value);
+            if (n.right != NIL) stack.push_back(n.right);
+            if (n.left != NIL) stack.push_back(n.left);
+        }
+        return out;
+    }
+    std::vector<int> postorder() const {
+        // Reverse of a root-right-left preorder
+        std::vector<int> out; out.reserve(size());
+        std::vector<int> stack;
+        if (root() != NIL) stack.push_back(root());
+        while (!stack.empty()) {
+            const Node& n = nodes_[stack.back()]; stack.pop_back();
+            out.push_back(n.value);
+            if (n.left != NIL) stack.push_back(n.left);
+            if (n.right != NIL) stack.push_back(n.right);
+        }
+        std::reverse(out.begin(), out.end());
+        return out;
+    }
+    std::vector<int> levelorder() const {
+        std::vector<int> out; out.reserve(size());
+        if (root() == NIL) return out;
+        std::queue<int> q; q.push(root());
+        while (!q.empty()) {
+            const Node& n = nodes_[q.front()]; q.pop();
+            out.push_back(n.value);
+            if (n.left != NIL) q.push(n.left);
+            if (n.right != NIL) q.push(n.right);
+        }
+        return out;
+    }
+
+private:
+    friend class TreeBalancing;
+
+    struct Version {
+        int root;
+        Balance balance;
+    };
+
+    // One step of a descent: the node and whether the walk went on to its left child
+    struct Step {
+        int node;
+        bool left;
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<Version> versions_;
+    std::vector<Rotation> rotations_;
+    int current_{0};
+    int dropped_{0};
+    int collectAt_{MIN_COLLECT_SLOTS}; // arena size that triggers the next collection
+    int fresh_{0}; // nodes from here on belong to the operation in progress
+    Balance working_{Balance::None}; // balancing of the operation in progress
+
+    void begin() {
+        fresh_ = (int)nodes_.size();
+        working_ = balance();
+        rotations_.clear();
+    }
+
+    void publish(int root, Balance balance) {
+        versions_.resize(current_ + 1);
+        versions_.push_back({root, balance});
+        current_ = (int)versions_.size() - 1;
+        if ((int)nodes_.size() > collectAt_) {
+            collect();
+            collectAt_ = std::max(MIN_COLLECT_SLOTS, 2 * (int)nodes_.size());
+        }
+    }
+
+    // Keeps the newest versions whose nodes fit the history cap, and moves the nodes they reach
+    // into a new arena. Marking goes newest version first, so each version is charged only the
+    // nodes it does not share with a newer one.
+    void collect() {
+        std::vector<int> moved(nodes_.size(), NIL); // new index of each reached node
+        std::vector<int> reached;
+        std::vector<int> pending;
+        int keep = (int)versions_.size(); // versions from here on survive
+        long long largest = 0;
+        while (keep > 0) {
+            int root = versions_[keep - 1].root;
+            size_t before = reached.size();
+            if (root != NIL && moved[root] == NIL) pending.push_back(root);
+            while (!pending.empty()) {
+                int n = pending.back();
+                pending.pop_back();
+                moved[n] = (int)reached.size();
+                reached.push_back(n);
+                if (nodes_[n].right != NIL && moved[nodes_[n].right] == NIL) pending.push_back(nodes_[n].right);
+                if (nodes_[n].left != NIL && moved[nodes_[n].left] == NIL) pending.push_back(nodes_[n].left);
+            }
+            largest = std::max<long long>(largest, sizeOf(root));
+            bool newest = keep == (int)versions_.size();
+            if (!newest && (long long)reached.size() > HISTORY_TREES * largest + MIN_COLLECT_SLOTS) {
+                for (size_t i = before; i < reached.size(); ++i) moved[reached[i]] = NIL;
+                reached.resize(before);
+                break;
+            }
+            --keep;
+        }
+
+        std::vector<Node> kept(reached.size());
+        for (size_t i = 0; i < reached.size(); ++i) {
+            Node n = nodes_[reached[i]];
+            if (n.left != NIL) n.left = moved[n.left];
+            if (n.right != NIL) n.right = moved[n.right];
+            kept[i] = n;
+        }
+        nodes_.swap(kept);
+        versions_.erase(versions_.begin(), versions_.begin() + keep);
+        for (Version& v : versions_) if (v.root != NIL) v.root = moved[v.root];
+        current_ -= keep;
+        dropped_ += keep;
+    }
+
+    int allocate(int v) {
+        nodes_.push_back({v, NIL, NIL, 0, 1, true});
+        return (int)nodes_.size() - 1;
+    }
+
+    // TreeBalancing hooks. own() gives the node itself when this operation made it, else a copy
+    // that it may change; there are no parent links to fix after a rotation.
+    Node& at(int i) { return nodes_[i]; }
+    int own(int i) {
+        if (i == NIL || i >= fresh_) return i;
+        nodes_.push_back(nodes_[i]);
+        return (int)nodes_.size() - 1;
+    }
+    Balance balancing() const { return working_; }
+    void rotated(int, int, int) {}
+    void dropLeaf(int) {}
+    int attach(int v, int parent, bool left, bool red) {
+        int node = allocate(v);
+        nodes_[node].red = red;
+        if (parent == NIL) return node;
+        if (left) nodes_[parent].left = node;
+        else nodes_[parent].right = node;
+        return node;
+    }
+
+    // Copies the path bottom-up, hanging `child` where the descent ended and rebalancing each
+    // copy; returns the new root
+    int rebuildPath(const std::vector<Step>& path, int child) {
+        for (int i = (int)path.size() - 1; i >= 0; --i) {
+            int p = own(path[i].node);
+            if (path[i].left) nodes_[p].left = child; else nodes_[p].right = child;
+            child = TreeBalancing::rebalance(*this, p);
+        }
+        return child;
+    }
+
+    // insert() for a tree under construction (rebalance): no version between the keys
+    int insertOwned(int top, int v) {
+        std::vector<Step> path;
+        for (int cur = top; cur != NIL;) {
+            path.push_back({cur, v < nodes_[cur].value});
+            cur = path.back().left ? nodes_[cur].left : nodes_[cur].right;
+        }
+        top = rebuildPath(path, allocate(v));
+        if (working_ == Balance::RedBlack) nodes_[top].red = false;
+        return top;
+    }
+
+    int removeUnbalanced(int v) {
+        std::vector<Step> path;
+        int n = root();
+        while (nodes_[n].value != v) {
+            path.push_back({n, v < nodes_[n].value});
+            n = path.back().left ? nodes_[n].left : nodes_[n].right;
+        }
+        // Two children: the successor's value moves up into n's copy and the successor is unlinked
+        int target = n, holder = -1;
+        if (nodes_[n].left != NIL && nodes_[n].right != NIL) {
+            holder = (int)path.size();
+            path.push_back({n, false});
+            target = nodes_[n].right;
+            while (nodes_[target].left != NIL) {
+                path.push_back({target, true});
+                target = nodes_[target].left;
+            }
+        }
+        int child = nodes_[target].left != NIL ? nodes_[target].left : nodes_[target].right;
+        for (int i = (int)path.size() - 1; i >= 0; --i) {
+            int p = own(path[i].node);
+            if (i == holder) nodes_[p].value = nodes_[target].value;
+            if (path[i].left) nodes_[p].left = child; else nodes_[p].right = child;
+            child = TreeBalancing::rebalance(*this, p);
+        }
+        return child;
+    }
+
+    int heightOf(int node) const { return node == NIL ? -1 : nodes_[node].height; }
+    int sizeOf(int node) const { return node == NIL ? 0 : nodes_[node].size; }
+};
+
+#endif // PERSISTENT_TREE_H
@@ -0,0 +1,260 @@
+#ifndef TRAVERSAL_H
+#define TRAVERSAL_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+// One visit reported by a traversal cursor
+struct TraversalStep {
+    int vertex{-1};
+    int parent{-1};              // vertex it was reached from; -1 for the start
+    int depth{0};                // BFS: hop distance; DFS: depth in the DFS tree
+    long long edgesExamined{0};  // arcs scanned before this visit
+};
+
+// Neighbour access shared by the cursors: lists of plain targets, (to, weight) pairs or
+// UnifiedGraph::Edge. Graphs stored some other way provide their own traversalNeighbors.
+inline int traversalTarget(int v) { return v; }
+inline int traversalTarget(const std::pair<int, int>& e) { return e.first; }
+template <class E>
+int traversalTarget(const E& e) { return e.to; }
+
+template <class Graph, class F>
+void traversalNeighbors(const Graph& g, int u, F&& fn) {
+    for (const auto& e : g.neighbors(u)) fn(traversalTarget(e));
+}
+
+// Where a DFS frame stopped in its vertex's neighbour list, so the walk can resume there after a
+// deeper visit. Adjacency lists only use index; CompressedGraph also keeps the byte offset of the
+// next gap and the last ID it decoded.
+struct NeighborPosition {
+    int index{0};
+    int last{0};
+    long long offset{0};
+};
+
+// Stores u's neighbour at pos in v and steps pos past it; false once the list is done
+template <class Graph>
+bool traversalNextNeighbor(const Graph& g, int u, NeighborPosition& pos, int& v) {
+    const auto& list = g.neighbors(u);
+    if ((size_t)pos.index >= list.size()) return false;
+    v = traversalTarget(list[pos.index++]);
+    return true;
+}
+
+// Visited set for repeated traversals: one bit per vertex in 64-bit words, each word tagged with
+// the generation that last wrote it. clear() bumps the generation so every stale word reads as
+// empty and is zeroed lazily on its next write, making a reset O(1) instead of O(V).
+class VisitedSet {
+public:
+    // Grows only; existing bits keep their generation
+    void resize(int n) {
+        size_t words = ((size_t)std::max(n, 0) + 63) / 64;
+        if (words > bits.size()) {
+            bits.resize(words, 0);
+            stamp.resize(words, 0);
+        }
+    }
+
+    void clear() {
+        if (++generation == 0) {
+            // Wrapped after 2^32 clears: stamps from the previous cycle could look current
+            std::fill(stamp.begin(), stamp.end(), 0u);
+            generation = 1;
+        }
+    }
+
+    bool test(int v) const {
+        size_t w = (size_t)v >> 6;
+        return stamp[w] == generation && (bits[w] >> (v & 63) & 1);
+    }
+
+    // Marks v; returns false if it already was
+    bool insert(int v) {
+        size_t w = (size_t)v >> 6;
+        uint64_t bit = uint64_t(1) << (v & 63);
+        if (stamp[w] != generation) {
+            stamp[w] = generation;
+            bits[w] = bit;
+            return true;
+        }
+        if (bits[w] & bit) return false;
+        bits[w] |= bit;
+        return true;
+    }
+
+private:
+    std::vector<uint64_t> bits;
+    std::vector<uint32_t> stamp;
+    uint32_t generation{1};
+};
+
+// FIFO over a power-of-two ring. clear() keeps the storage, so once it has grown to the largest
+// frontier seen, later traversals push and pop without allocating.
+template <class T>
+class RingQueue {
+public:
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    void clear() { head = count = 0; }
+
+    void push_back(const T& x) {
+        if (count == ring.size()) regrow(count + 1);
+        ring[(head + count) & (ring.size() - 1)] = x;
+        ++count;
+    }
+
+    const T& front() const { return ring[head]; }
+
+    void pop_front() {
+        head = (head + 1) & (ring.size() - 1);
+        --count;
+    }
+
+private:
+    void regrow(size_t atLeast) {
+        size_t capacity = 16;
+        while (capacity < atLeast) capacity *= 2;
+        std::vector<T> next(capacity);
+        for (size_t i = 0; i < count; ++i) next[i] = ring[(head + i) & (ring.size() - 1)];
+        ring.swap(next);
+        head = 0;
+    }
+
+    std::vector<T> ring;
+    size_t head{0}, count{0};
+};
+
+struct TraversalEntry {
+    int vertex, parent, depth;
+};
+
+struct DfsFrame {
+    int vertex, parent, depth;
+    NeighborPosition next; // first neighbour not yet examined
+};
+
+// Everything a BFS or DFS needs besides the graph. One workspace reused across traversals (for
+// example a BFS from every vertex) allocates only while the graph or the largest frontier grows.
+// A workspace serves one live cursor at a time.
+class TraversalWorkspace {
+public:
+    void begin(int n) {
+        visited.resize(n);
+        visited.clear();
+        queue.clear();
+        stack.clear();
+    }
+
+    VisitedSet visited;
+    RingQueue<TraversalEntry> queue; // BFS frontier; keeps its ring
+    std::vector<DfsFrame> stack;     // DFS: one frame per vertex on the current path; keeps its capacity
+};
+
+// Pull-based BFS: next() yields one visit at a time, so a caller can stop as soon as it has what
+// it needs. A vertex's neighbours are only scanned when the following visit is requested, and
+// memory is the frontier plus one visited bit per vertex, both held in a TraversalWorkspace.
+// The graph must not change while a cursor is live. A start outside [0, vertexCount()) yields
+// nothing.
+template <class Graph>
+class BfsCursor {
+public:
+    // Uses a private workspace
+    BfsCursor(const Graph& g, int start) : owned(std::make_shared<TraversalWorkspace>()), graph(&g), ws(owned.get()) {
+        init(start);
+    }
+
+    // Borrows workspace, which must outlive the cursor; copies of a cursor share their workspace
+    BfsCursor(const Graph& g, int start, TraversalWorkspace& workspace) : graph(&g), ws(&workspace) { init(start); }
+
+    bool next(TraversalStep& step) {
+        if (pending.vertex >= 0) {
+            traversalNeighbors(*graph, pending.vertex, [&](int v) {
+                ++examined;
+                if (ws->visited.insert(v)) ws->queue.push_back({v, pending.vertex, pending.depth + 1});
+            });
+            pending.vertex = -1;
+        }
+        if (ws->queue.empty()) return false;
+        pending = ws->queue.front();
+        ws->queue.pop_front();
+        step = {pending.vertex, pending.parent, pending.depth, examined};
+        return true;
+    }
+
+    long long edgesExamined() const { return examined; }
+
+private:
+    void init(int start) {
+        ws->begin(graph->vertexCount());
+        if (start < 0 || start >= graph->vertexCount()) return;
+        ws->visited.insert(start);
+        ws->queue.push_back({start, -1, 0});
+    }
+
+    std::shared_ptr<TraversalWorkspace> owned;
+    const Graph* graph;
+    TraversalWorkspace* ws;
+    TraversalEntry pending{-1, -1, 0}; // last visit, neighbours not yet scanned
+    long long examined{0};
+};
+
+// Pull-based DFS with the same order as the recursive one. Each vertex on the current path has a
+// frame that remembers how far its neighbour list has been examined, so a neighbour is looked at
+// only when the walk comes back to that vertex, and memory is O(depth) frames plus one visited
+// bit per vertex rather than an entry per arc.
+template <class Graph>
+class DfsCursor {
+public:
+    DfsCursor(const Graph& g, int start) : owned(std::make_shared<TraversalWorkspace>()), graph(&g), ws(owned.get()) {
+        init(start);
+    }
+
+    DfsCursor(const Graph& g, int start, TraversalWorkspace& workspace) : graph(&g), ws(&workspace) { init(start); }
+
+    bool next(TraversalStep& step) {
+        std::vector<DfsFrame>& stack = ws->stack;
+        if (startPending) {
+            startPending = false;
+            step = {stack.back().vertex, -1, 0, 0};
+            return true;
+        }
+        while (!stack.empty()) {
+            DfsFrame& top = stack.back();
+            int v;
+            bool found = false;
+            while (traversalNextNeighbor(*graph, top.vertex, top.next, v)) {
+                ++examined;
+                if (ws->visited.insert(v)) { found = true; break; }
+            }
+            if (!found) { stack.pop_back(); continue; }
+            DfsFrame child{v, top.vertex, top.depth + 1, {}};
+            stack.push_back(child); // may move top
+            step = {child.vertex, child.parent, child.depth, examined};
+            return true;
+        }
+        return false;
+    }
+
+    long long edgesExamined() const { return examined; }
+
+private:
+    void init(int start) {
+        ws->begin(graph->vertexCount());
+        if (start < 0 || start >= graph->vertexCount()) return;
+        ws->visited.insert(start);
+        ws->stack.push_back({start, -1, 0, {}});
+        startPending = true;
+    }
+
+    std::shared_ptr<TraversalWorkspace> owned;
+    const Graph* graph;
+    TraversalWorkspace* ws;
+    bool startPending{false}; // start is on the stack but not reported yet
+    long long examined{0};
+};
+
+#endif // TRAVERSAL_H
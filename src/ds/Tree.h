@@ -5,144 +5,323 @@
 #include <queue>
 #include <algorithm>
 #include <limits>
+#include "../algo/Parallel.h"
+#include "TreeBalancing.h"
 
+// Nodes live in one contiguous arena and link by 32-bit index (NIL = -1) instead of pointer.
+// Removed slots go on a free list threaded through `left`, so inserts reuse them, and clear()
+// drops the whole arena at once while keeping its capacity.
+//
+// The tree is either a plain BST or self-balancing: AVL (subtree heights differ by at most one)
+// or left-leaning red-black (Sedgewick's 2-3 variant: red links lean left, never two in a row).
+// Both keep height O(log n); the rules live in TreeBalancing, shared with PersistentTree. Every
+// rotation of the last insert/remove is reported in lastRotations() so a view can animate it.
+//
+// Each node caches its subtree height and size, refreshed along the path an update walks back
+// up, so height() is O(1) and select(k)/rank(v) are order-statistic queries in O(height).
+//
+// build() makes a perfectly balanced tree from unordered keys in one sort plus O(n) linking,
+// instead of n separate inserts.
+//
+// Nothing recurses: parent links let insert/remove walk back up to rebalance, and the depth-first
+// traversals step from node to node in O(1) extra memory, so even a degenerate tree of millions
+// of nodes (sorted input into a plain BST) cannot overflow the call stack.
 class BSTree {
 public:
+    static constexpr int NIL = -1;
+
+    enum class Balance { None, AVL, RedBlack };
+
     struct Node {
         int value;
-        Node* left;
-        Node* right;
-        Node(int v): value(v), left(nullptr), right(nullptr) {}
+        int left;
+        int right;
+        int parent;
+        int height; // leaf = 0
+        int size;   // nodes in this subtree
+        bool red;   // red-black only: colour of the link from the parent
     };
 
-    BSTree(): root_(nullptr), count_(0) {}
+    // A left rotation lifts `child` (the pivot's right child) above `pivot`; right is the mirror
+    struct Rotation {
+        bool left;
+        int pivot;
+        int child;
+    };
 
-    ~BSTree() { clear(); }
+    explicit BSTree(Balance balance = Balance::None): balance_(balance), root_(NIL), count_(0), free_(NIL) {}
+
+    Balance balance() const { return balance_; }
 
     bool insert(int v) {
-        bool inserted = false;
-        root_ = insertRec(root_, v, inserted);
-        if (inserted) ++count_;
-        return inserted;
+        rotations_.clear();
+        int parent = NIL, cur = root_;
+        while (cur != NIL) {
+            if (v == nodes_[cur].value) return false; // no duplicates
+            parent = cur;
+            cur = v < nodes_[cur].value ? nodes_[cur].left : nodes_[cur].right;
+        }
+        int n = allocate(v, parent);
+        replaceChild(parent, NIL, n, v);
+        ++count_;
+        rebalanceUpward(parent);
+        if (balance_ == Balance::RedBlack) nodes_[root_].red = false;
+        return true;
     }
 
     bool contains(int v) const {
-        Node* cur = root_;
-        while (cur) {
-            if (v == cur->value) return true;
-            cur = v < cur->value ? cur->left : cur->right;
+        int cur = root_;
+        while (cur != NIL) {
+            const Node& n = nodes_[cur];
+            if (v == n.value) return true;
+            cur = v < n.value ? n.left : n.right;
         }
         return false;
     }
 
     bool remove(int v) {
-        bool removed = false;
-        root_ = removeRec(root_, v, removed);
-        if (removed) --count_;
-        return removed;
+        rotations_.clear();
+        if (balance_ == Balance::RedBlack) return removeRedBlack(v);
+        int n = find(v);
+        if (n == NIL) return false;
+        // Two children: take the successor's value and unlink the successor instead
+        if (nodes_[n].left != NIL && nodes_[n].right != NIL) {
+            int succ = minNode(nodes_[n].right);
+            nodes_[n].value = nodes_[succ].value;
+            n = succ;
+        }
+        int child = nodes_[n].left != NIL ? nodes_[n].left : nodes_[n].right;
+        int parent = nodes_[n].parent;
+        replaceChild(parent, n, child);
+        if (child != NIL) nodes_[child].parent = parent;
+        release(n);
+        --count_;
+        rebalanceUpward(parent);
+        return true;
+    }
+
+    // Replaces the contents with `values` (any order, duplicates dropped); large inputs are sorted
+    // in parallel. Returns the number of keys kept.
+    int build(std::vector<int> values) {
+        Parallel::sort(values);
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        buildSorted(values);
+        return count_;
+    }
+
+    // Replaces the contents with strictly increasing keys in O(n), perfectly balanced (see
+    // TreeBalancing::buildSorted)
+    void buildSorted(const std::vector<int>& sorted) {
+        clear();
+        nodes_.reserve(sorted.size());
+        root_ = TreeBalancing::buildSorted(*this, sorted);
+        count_ = (int)sorted.size();
     }
 
+    const std::vector<Rotation>& lastRotations() const { return rotations_; }
+
+    // O(1): nodes are plain data, so the arena is emptied without visiting them
     void clear() {
-        clearRec(root_);
-        root_ = nullptr;
+        nodes_.clear();
+        rotations_.clear();
+        root_ = NIL;
         count_ = 0;
+        free_ = NIL;
     }
 
     int size() const { return count_; }
 
-    int height() const { return heightRec(root_); }
+    int height() const { return heightOf(root_); }
+
+    // k-th smallest key, 0-based; INT_MIN when k is out of range. path, if given, receives the
+    // keys visited on the way down.
+    int select(int k, std::vector<int>* path = nullptr) const {
+        if (path) path->clear();
+        if (k < 0 || k >= count_) return std::numeric_limits<int>::min();
+        int n = root_;
+        for (;;) {
+            if (path) path->push_back(nodes_[n].value);
+            int leftSize = sizeOf(nodes_[n].left);
+            if (k == leftSize) return nodes_[n].value;
+            if (k < leftSize) n = nodes_[n].left;
+            else { k -= leftSize + 1; n = nodes_[n].right; }
+        }
+    }
+
+    // Number of keys smaller than v (v itself need not be present)
+    int rank(int v, std::vector<int>* path = nullptr) const {
+        if (path) path->clear();
+        int r = 0, n = root_;
+        while (n != NIL) {
+            if (path) path->push_back(nodes_[n].value);
+            if (v < nodes_[n].value) n = nodes_[n].left;
+            else if (v == nodes_[n].value) return r + sizeOf(nodes_[n].left);
+            else { r += sizeOf(nodes_[n].left) + 1; n = nodes_[n].right; }
+        }
+        return r;
+    }
 
-    Node* getRoot() const { return root_; }
+    int root() const { return root_; }
+    const Node& node(int i) const { return nodes_[i]; }
+    // Arena slots, free ones included: every node index is below this
+    int slotCount() const { return (int)nodes_.size(); }
 
     // Min/Max
     int min() const {
-        if (!root_) return std::numeric_limits<int>::min();
-        Node* n = root_;
-        while (n->left) n = n->left;
-        return n->value;
+        if (root_ == NIL) return std::numeric_limits<int>::min();
+        int n = root_;
+        while (nodes_[n].left != NIL) n = nodes_[n].left;
+        return nodes_[n].value;
     }
     int max() const {
-        if (!root_) return std::numeric_limits<int>::max();
-        Node* n = root_;
-        while (n->right) n = n->right;
-        return n->value;
+        if (root_ == NIL) return std::numeric_limits<int>::max();
+        int n = root_;
+        while (nodes_[n].right != NIL) n = nodes_[n].right;
+        return nodes_[n].value;
     }
 
-    // Traversals
+    // Traversals (the depth-first ones follow parent links: no stack, no recursion)
     std::vector<int> inorder() const {
         std::vector<int> out; out.reserve(count_);
-        inorderRec(root_, out); return out;
+        for (int n = minNode(root_); n != NIL; n = successor(n)) out.push_back(nodes_[n].value);
+        return out;
     }
     std::vector<int> preorder() const {
         std::vector<int> out; out.reserve(count_);
-        preorderRec(root_, out); return out;
+        for (int n = root_; n != NIL;) {
+            out.push_back(nodes_[n].value);
+            if (nodes_[n].left != NIL) n = nodes_[n].left;
+            else if (nodes_[n].right != NIL) n = nodes_[n].right;
+            else n = climbToNextSubtree(n);
+        }
+        return out;
     }
     std::vector<int> postorder() const {
         std::vector<int> out; out.reserve(count_);
-        postorderRec(root_, out); return out;
+        for (int n = firstLeaf(root_); n != NIL;) {
+            out.push_back(nodes_[n].value);
+            int p = nodes_[n].parent;
+            n = (p != NIL && nodes_[p].left == n && nodes_[p].right != NIL) ? firstLeaf(nodes_[p].right) : p;
+        }
+        return out;
     }
     std::vector<int> levelorder() const {
         std::vector<int> out; out.reserve(count_);
-        if (!root_) return out;
-        std::queue<Node*> q; q.push(root_);
+        if (root_ == NIL) return out;
+        std::queue<int> q; q.push(root_);
         while (!q.empty()) {
-            Node* n = q.front(); q.pop();
-            out.push_back(n->value);
-            if (n->left) q.push(n->left);
-            if (n->right) q.push(n->right);
+            const Node& n = nodes_[q.front()]; q.pop();
+            out.push_back(n.value);
+            if (n.left != NIL) q.push(n.left);
+            if (n.right != NIL) q.push(n.right);
         }
         return out;
     }
 
 private:
-    Node* root_;
+    friend class TreeBalancing;
+
+    Balance balance_;
+    std::vector<Node> nodes_;
+    std::vector<Rotation> rotations_;
+    int root_;
     int count_;
+    int free_; // head of the free list
 
-    static Node* insertRec(Node* node, int v, bool& inserted) {
-        if (!node) { inserted = true; return new Node(v); }
-        if (v == node->value) return node; // no duplicates
-        if (v < node->value) node->left = insertRec(node->left, v, inserted);
-        else node->right = insertRec(node->right, v, inserted);
-        return node;
-    }
-
-    static Node* minNode(Node* node) { while (node && node->left) node = node->left; return node; }
-
-    static Node* removeRec(Node* node, int v, bool& removed) {
-        if (!node) return nullptr;
-        if (v < node->value) node->left = removeRec(node->left, v, removed);
-        else if (v > node->value) node->right = removeRec(node->right, v, removed);
-        else {
-            removed = true;
-            if (!node->left) { Node* r = node->right; delete node; return r; }
-            if (!node->right) { Node* l = node->left; delete node; return l; }
-            Node* succ = minNode(node->right);
-            node->value = succ->value;
-            node->right = removeRec(node->right, succ->value, removed = true);
+    int allocate(int v, int parent) {
+        if (free_ != NIL) {
+            int i = free_;
+            free_ = nodes_[i].left;
+            nodes_[i] = {v, NIL, NIL, parent, 0, 1, true};
+            return i;
         }
-        return node;
+        nodes_.push_back({v, NIL, NIL, parent, 0, 1, true});
+        return (int)nodes_.size() - 1;
     }
 
-    static void clearRec(Node* node) {
-        if (!node) return;
-        clearRec(node->left);
-        clearRec(node->right);
-        delete node;
+    // New node hung under parent (or made the root) for buildSorted
+    int attach(int v, int parent, bool left, bool red) {
+        int n = allocate(v, parent);
+        nodes_[n].red = red;
+        if (parent == NIL) root_ = n;
+        else if (left) nodes_[parent].left = n;
+        else nodes_[parent].right = n;
+        return n;
     }
 
-    static int heightRec(Node* node) {
-        if (!node) return -1;
-        return 1 + std::max(heightRec(node->left), heightRec(node->right));
-        }
+    // TreeBalancing hooks: nodes change in place, and rotations fix the parent links
+    Node& at(int i) { return nodes_[i]; }
+    int own(int i) { return i; }
+    Balance balancing() const { return balance_; }
+    void rotated(int h, int x, int moved) {
+        int p = nodes_[h].parent;
+        if (moved != NIL) nodes_[moved].parent = h;
+        nodes_[h].parent = x;
+        nodes_[x].parent = p;
+        replaceChild(p, h, x);
+    }
+    void dropLeaf(int i) { release(i); }
+
+    void release(int i) {
+        nodes_[i].left = free_;
+        free_ = i;
+    }
+
+    int find(int v) const {
+        int cur = root_;
+        while (cur != NIL && nodes_[cur].value != v) cur = v < nodes_[cur].value ? nodes_[cur].left : nodes_[cur].right;
+        return cur;
+    }
+
+    // Points parent's link that held `from` (or the root) at `to`. With from == NIL the side is
+    // chosen by `value`, for attaching a new leaf.
+    void replaceChild(int parent, int from, int to, int value = 0) {
+        if (parent == NIL) root_ = to;
+        else if (from != NIL ? nodes_[parent].left == from : value < nodes_[parent].value) nodes_[parent].left = to;
+        else nodes_[parent].right = to;
+    }
+
+    // Refreshes the cached fields (and the balance) of node and every ancestor
+    void rebalanceUpward(int node) {
+        while (node != NIL) node = nodes_[TreeBalancing::rebalance(*this, node)].parent;
+    }
+
+    int heightOf(int node) const { return node == NIL ? -1 : nodes_[node].height; }
+    int sizeOf(int node) const { return node == NIL ? 0 : nodes_[node].size; }
+
+    bool removeRedBlack(int v) {
+        // The top-down pass assumes the key is present
+        if (!contains(v)) return false;
+        root_ = TreeBalancing::removeRedBlack(*this, root_, v);
+        --count_;
+        return true;
+    }
+
+    int minNode(int node) const { while (node != NIL && nodes_[node].left != NIL) node = nodes_[node].left; return node; }
 
-    static void inorderRec(Node* n, std::vector<int>& out) {
-        if (!n) return; inorderRec(n->left, out); out.push_back(n->value); inorderRec(n->right, out);
+    int successor(int n) const {
+        if (nodes_[n].right != NIL) return minNode(nodes_[n].right);
+        int p = nodes_[n].parent;
+        while (p != NIL && nodes_[p].right == n) { n = p; p = nodes_[p].parent; }
+        return p;
     }
-    static void preorderRec(Node* n, std::vector<int>& out) {
-        if (!n) return; out.push_back(n->value); preorderRec(n->left, out); preorderRec(n->right, out);
+
+    // First node of a postorder walk: keep descending, left when possible
+    int firstLeaf(int n) const {
+        while (n != NIL) {
+            if (nodes_[n].left != NIL) n = nodes_[n].left;
+            else if (nodes_[n].right != NIL) n = nodes_[n].right;
+            else return n;
+        }
+        return NIL;
     }
-    static void postorderRec(Node* n, std::vector<int>& out) {
-        if (!n) return; postorderRec(n->left, out); postorderRec(n->right, out); out.push_back(n->value);
+
+    // From a finished subtree at n, climb to the nearest ancestor with an unvisited right subtree
+    // and return that subtree's root (NIL when the walk is done)
+    int climbToNextSubtree(int n) const {
+        for (int p = nodes_[n].parent; p != NIL; n = p, p = nodes_[p].parent)
+            if (nodes_[p].left == n && nodes_[p].right != NIL) return nodes_[p].right;
+        return NIL;
     }
 };
 
@@ -0,0 +1,241 @@
+#ifndef TREE_BALANCING_H
+#define TREE_BALANCING_H
+
+#include <vector>
+#include <algorithm>
+
+// The AVL and left-leaning red-black rules, written once for BSTree and PersistentTree so both
+// give a key sequence the same shape. Each function is templated over the tree and reaches its
+// nodes through a few private hooks (the trees befriend this class):
+//
+//   Node& at(int)                 the node at an index
+//   int own(int)                  an index the caller may change: BSTree hands it back as is,
+//                                 PersistentTree copies a node that an earlier version owns
+//   Balance balancing() const     the rules to apply
+//   void rotated(int h, int x, int moved)
+//                                 x has just come up over h and `moved` (x's inner child, maybe
+//                                 NIL) went across to h; BSTree fixes parent links here
+//   void dropLeaf(int)            a leaf removeRedBlack has unlinked
+//   int attach(int v, int parent, bool left, bool red)
+//                                 a new node for buildSorted, hung under parent (NIL: the root)
+//   std::vector<Rotation> rotations_
+//
+// Rotations take an owned node and return the subtree's new root; callers store it in the
+// parent's link even where the hook already did.
+class TreeBalancing {
+public:
+    template <class T>
+    static void update(T& t, int node) {
+        auto& n = t.at(node);
+        n.height = 1 + std::max(heightOf(t, n.left), heightOf(t, n.right));
+        n.size = 1 + sizeOf(t, n.left) + sizeOf(t, n.right);
+    }
+
+    // Restores the balancing invariant at an owned node on the way back up; returns the
+    // subtree's new root
+    template <class T>
+    static int rebalance(T& t, int node) {
+        update(t, node);
+        if (t.balancing() == T::Balance::AVL) {
+            int bf = balanceFactor(t, node);
+            if (bf > 1) {
+                if (balanceFactor(t, t.at(node).left) < 0) t.at(node).left = rotateLeft(t, t.own(t.at(node).left));
+                return rotateRight(t, node);
+            }
+            if (bf < -1) {
+                if (balanceFactor(t, t.at(node).right) > 0) t.at(node).right = rotateRight(t, t.own(t.at(node).right));
+                return rotateLeft(t, node);
+            }
+        } else if (t.balancing() == T::Balance::RedBlack) {
+            if (isRed(t, t.at(node).right) && !isRed(t, t.at(node).left)) node = rotateLeft(t, node);
+            if (isRed(t, t.at(node).left) && isRed(t, t.at(t.at(node).left).left)) node = rotateRight(t, node);
+            if (isRed(t, t.at(node).left) && isRed(t, t.at(node).right)) flipColors(t, node);
+        }
+        return node;
+    }
+
+    // Left-leaning red-black deletion of a key that is present, from an owned root. On the way
+    // down it borrows a red link so the node that finally goes is never a lone black (a 2-node);
+    // rebalance() cleans up on the way back. Each node is owned as the descent reaches it.
+    // Returns the new root.
+    template <class T>
+    static int removeRedBlack(T& t, int root, int v) {
+        constexpr int NIL = T::NIL;
+        int top = root;
+        if (!isRed(t, t.at(top).left) && !isRed(t, t.at(top).right)) t.at(top).red = true;
+        struct Step { int node; bool left; };
+        std::vector<Step> path; // owned ancestors of h
+        auto relink = [&](int h) {
+            if (path.empty()) top = h;
+            else if (path.back().left) t.at(path.back().node).left = h;
+            else t.at(path.back().node).right = h;
+        };
+        auto descend = [&](int h, bool left) {
+            path.push_back({h, left});
+            int next = t.own(left ? t.at(h).left : t.at(h).right);
+            relink(next);
+            return next;
+        };
+        int h = top;
+        bool toMin = false; // v was found; now removing the minimum of its right subtree
+        for (;;) {
+            if (toMin || v < t.at(h).value) {
+                if (toMin && t.at(h).left == NIL) break;
+                if (!isRed(t, t.at(h).left) && !isRed(t, t.at(t.at(h).left).left)) { h = moveRedLeft(t, h); relink(h); }
+                h = descend(h, true);
+                continue;
+            }
+            if (isRed(t, t.at(h).left)) { h = rotateRight(t, h); relink(h); }
+            if (v == t.at(h).value && t.at(h).right == NIL) break;
+            if (!isRed(t, t.at(h).right) && !isRed(t, t.at(t.at(h).right).left)) { h = moveRedRight(t, h); relink(h); }
+            if (v == t.at(h).value) {
+                int m = t.at(h).right;
+                while (t.at(m).left != NIL) m = t.at(m).left;
+                t.at(h).value = t.at(m).value;
+                toMin = true;
+            }
+            h = descend(h, false);
+        }
+        // h is a leaf now: unlink it, then rebalance the path bottom-up
+        int child = NIL;
+        for (int i = (int)path.size() - 1; i >= 0; --i) {
+            int p = path[i].node;
+            if (path[i].left) t.at(p).left = child; else t.at(p).right = child;
+            child = rebalance(t, p);
+        }
+        t.dropLeaf(h);
+        if (child != NIL) t.at(child).red = false;
+        return child;
+    }
+
+    // Links strictly increasing keys into new nodes in O(n); returns the root. Each subtree takes
+    // its middle key as root, so the height is floor(log2 n) and AVL balance holds everywhere.
+    // Red-black trees are cut as a 2-3 tree instead: a range becomes a single black node or a
+    // black node with a red left child, sized so every root-to-leaf path crosses the same number
+    // of black nodes. attach() must hand out consecutive indices; parents come before their
+    // children, so one backward pass fills in the cached heights and sizes.
+    template <class T>
+    static int buildSorted(T& t, const std::vector<int>& sorted) {
+        constexpr int NIL = T::NIL;
+        int n = (int)sorted.size();
+        if (n == 0) return NIL;
+        bool redBlack = t.balancing() == T::Balance::RedBlack;
+
+        // capacity[k]: most keys a 2-3 tree with k black levels can hold (3^k - 1)
+        int blackHeight = 0;
+        while ((1LL << (blackHeight + 1)) - 1 <= n) ++blackHeight;
+        std::vector<long long> capacity(blackHeight + 1, 0);
+        for (int k = 1; k <= blackHeight; ++k) capacity[k] = capacity[k - 1] * 3 + 2;
+
+        int first = NIL, last = NIL;
+        auto attach = [&](int v, int parent, bool left, bool red) {
+            last = t.attach(v, parent, left, red);
+            if (first == NIL) first = last;
+            return last;
+        };
+        struct Range { int lo, hi, blackHeight, parent; bool left; };
+        std::vector<Range> pending{{0, n, blackHeight, NIL, false}};
+        while (!pending.empty()) {
+            Range r = pending.back();
+            pending.pop_back();
+            int count = r.hi - r.lo;
+            if (count == 0) continue;
+            int below = std::max(r.blackHeight - 1, 0);
+            if (!redBlack || count - 1 - (count - 1) / 2 <= capacity[below]) {
+                int mid = r.lo + (count - 1) / 2;
+                int node = attach(sorted[mid], r.parent, r.left, false);
+                pending.push_back({r.lo, mid, below, node, true});
+                pending.push_back({mid + 1, r.hi, below, node, false});
+            } else {
+                // Too many keys for two children: a 3-node splits the rest three ways
+                int rest = count - 2, a = rest / 3, b = (rest + 1) / 3;
+                int redKey = r.lo + a, blackKey = redKey + 1 + b;
+                int node = attach(sorted[blackKey], r.parent, r.left, false);
+                int red = attach(sorted[redKey], node, true, true);
+                pending.push_back({r.lo, redKey, below, red, true});
+                pending.push_back({redKey + 1, blackKey, below, red, false});
+                pending.push_back({blackKey + 1, r.hi, below, node, false});
+            }
+        }
+        for (int i = last; i >= first; --i) update(t, i);
+        return first;
+    }
+
+private:
+    template <class T>
+    static int heightOf(T& t, int node) { return node == T::NIL ? -1 : t.at(node).height; }
+    template <class T>
+    static int sizeOf(T& t, int node) { return node == T::NIL ? 0 : t.at(node).size; }
+    template <class T>
+    static int balanceFactor(T& t, int node) { return heightOf(t, t.at(node).left) - heightOf(t, t.at(node).right); }
+    template <class T>
+    static bool isRed(T& t, int node) { return node != T::NIL && t.at(node).red; }
+
+    template <class T>
+    static int rotateLeft(T& t, int h) {
+        int x = t.own(t.at(h).right);
+        int moved = t.at(x).left;
+        t.at(h).right = moved;
+        t.at(x).left = h;
+        t.rotated(h, x, moved);
+        finishRotation(t, h, x);
+        t.rotations_.push_back({true, t.at(h).value, t.at(x).value});
+        return x;
+    }
+
+    template <class T>
+    static int rotateRight(T& t, int h) {
+        int x = t.own(t.at(h).left);
+        int moved = t.at(x).right;
+        t.at(h).left = moved;
+        t.at(x).right = h;
+        t.rotated(h, x, moved);
+        finishRotation(t, h, x);
+        t.rotations_.push_back({false, t.at(h).value, t.at(x).value});
+        return x;
+    }
+
+    // h went down, x came up: cached fields bottom-up, red-black colour of the link moves to x
+    template <class T>
+    static void finishRotation(T& t, int h, int x) {
+        update(t, h);
+        update(t, x);
+        if (t.balancing() == T::Balance::RedBlack) {
+            t.at(x).red = t.at(h).red;
+            t.at(h).red = true;
+        }
+    }
+
+    template <class T>
+    static void flipColors(T& t, int h) {
+        t.at(h).left = t.own(t.at(h).left);
+        t.at(h).right = t.own(t.at(h).right);
+        t.at(h).red = !t.at(h).red;
+        t.at(t.at(h).left).red = !t.at(t.at(h).left).red;
+        t.at(t.at(h).right).red = !t.at(t.at(h).right).red;
+    }
+
+    template <class T>
+    static int moveRedLeft(T& t, int h) {
+        flipColors(t, h);
+        if (isRed(t, t.at(t.at(h).right).left)) {
+            t.at(h).right = rotateRight(t, t.at(h).right);
+            h = rotateLeft(t, h);
+            flipColors(t, h);
+        }
+        return h;
+    }
+
+    template <class T>
+    static int moveRedRight(T& t, int h) {
+        flipColors(t, h);
+        int l = t.at(h).left;
+        if (l != T::NIL && isRed(t, t.at(l).left)) {
+            h = rotateRight(t, h);
+            flipColors(t, h);
+        }
+        return h;
+    }
+};
+
+#endif // TREE_BALANCING_H
@@ -2,39 +2,68 @@
 #define UNDIRECTED_UNWEIGHTED_GRAPH_H
 
 #include <vector>
-#include <queue>
-#include <stack>
+#include <algorithm>
+#include "Traversal.h"
 
 // Simple undirected, unweighted graph using adjacency lists
 class UndirectedUnweightedGraph {
 public:
     UndirectedUnweightedGraph() : n(0) {}
 
-    int addVertex(){ adj.emplace_back(); return n++; }
+    int addVertex(){ adj.emplace_back(); alive.push_back(1); return n++; }
 
-    void addEdge(int u, int v){ ensureVertex(std::max(u,v)); adj[u].push_back(v); adj[v].push_back(u); }
+    void addEdge(int u, int v){ ensureVertex(std::max(u,v)); if(!alive[u]||!alive[v]) return; adj[u].push_back(v); adj[v].push_back(u); }
+
+    // Removes one u-v edge from both lists in O(deg(u) + deg(v)); a self-loop's two entries share u's list
+    bool removeEdge(int u, int v){
+        if(u<0||u>=n||v<0||v>=n) return false;
+        auto it=std::find(adj[u].begin(),adj[u].end(),v); if(it==adj[u].end()) return false;
+        adj[u].erase(it);
+        auto jt=std::find(adj[v].begin(),adj[v].end(),u); if(jt!=adj[v].end()) adj[v].erase(jt);
+        return true;
+    }
+
+    // Tombstones u (its ID stays reserved until compact()); only u's neighbours are touched
+    bool removeVertex(int u){
+        if(!isAlive(u)) return false;
+        for(int x:adj[u]){ if(x==u) continue; auto jt=std::find(adj[x].begin(),adj[x].end(),u); if(jt!=adj[x].end()) adj[x].erase(jt); }
+        std::vector<int>().swap(adj[u]); alive[u]=0;
+        return true;
+    }
+
+    bool isAlive(int u) const { return u>=0 && u<n && alive[u]; }
+
+    // Renumbers surviving vertices densely in their original order; returns newId[old] (-1 if removed)
+    std::vector<int> compact(){
+        std::vector<int> newId(n,-1); int next=0;
+        for(int v=0;v<n;++v) if(alive[v]) newId[v]=next++;
+        for(int v=0;v<n;++v){
+            if(newId[v]<0) continue;
+            for(int& x:adj[v]) x=newId[x];
+            if(newId[v]!=v) adj[newId[v]].swap(adj[v]);
+        }
+        adj.resize(next); alive.assign(next,1); n=next;
+        return newId;
+    }
 
     int vertexCount() const { return n; }
 
     const std::vector<int>& neighbors(int u) const { return adj[u]; }
 
+    BfsCursor<UndirectedUnweightedGraph> bfsCursor(int start) const { return BfsCursor<UndirectedUnweightedGraph>(*this, isAlive(start)?start:-1); }
+    BfsCursor<UndirectedUnweightedGraph> bfsCursor(int start, TraversalWorkspace& ws) const { return BfsCursor<UndirectedUnweightedGraph>(*this, isAlive(start)?start:-1, ws); }
+    DfsCursor<UndirectedUnweightedGraph> dfsCursor(int start) const { return DfsCursor<UndirectedUnweightedGraph>(*this, isAlive(start)?start:-1); }
+    DfsCursor<UndirectedUnweightedGraph> dfsCursor(int start, TraversalWorkspace& ws) const { return DfsCursor<UndirectedUnweightedGraph>(*this, isAlive(start)?start:-1, ws); }
+
     std::vector<int> bfs(int start) const {
-        std::vector<int> order; if(start<0||start>=n) return order;
-        std::vector<bool> vis(n,false); std::queue<int> q; q.push(start); vis[start]=true;
-        while(!q.empty()){
-            int u=q.front(); q.pop(); order.push_back(u);
-            for(int v:adj[u]) if(!vis[v]){ vis[v]=true; q.push(v);}    
-        }
+        std::vector<int> order; TraversalStep s;
+        for(auto c=bfsCursor(start); c.next(s);) order.push_back(s.vertex);
         return order;
     }
 
     std::vector<int> dfs(int start) const {
-        std::vector<int> order; if(start<0||start>=n) return order;
-        std::vector<bool> vis(n,false); std::stack<int> st; st.push(start);
-        while(!st.empty()){
-            int u=st.top(); st.pop(); if(vis[u]) continue; vis[u]=true; order.push_back(u);
-            for(int i=(int)adj[u].size()-1;i>=0;--i){ int v=adj[u][i]; if(!vis[v]) st.push(v);}    
-        }
+        std::vector<int> order; TraversalStep s;
+        for(auto c=dfsCursor(start); c.next(s);) order.push_back(s.vertex);
         return order;
     }
 
@@ -42,6 +71,7 @@ private:
     void ensureVertex(int idx){ while(idx>=n) addVertex(); }
     int n; 
     std::vector<std::vector<int>> adj;
+    std::vector<char> alive;
 };
 
 #endif // UNDIRECTED_UNWEIGHTED_GRAPH_H
@@ -2,9 +2,9 @@
 #define UNDIRECTED_WEIGHTED_GRAPH_H
 
 #include <vector>
-#include <queue>
-#include <stack>
 #include <utility>
+#include <algorithm>
+#include "Traversal.h"
 
 // Simple undirected, weighted graph using adjacency lists
 class UndirectedWeightedGraph {
@@ -13,32 +13,66 @@ public:
 
     UndirectedWeightedGraph() : n(0) {}
 
-    int addVertex(){ adj.emplace_back(); return n++; }
+    int addVertex(){ adj.emplace_back(); alive.push_back(1); return n++; }
 
-    void addEdge(int u, int v, int w){ ensureVertex(std::max(u,v)); adj[u].emplace_back(v,w); adj[v].emplace_back(u,w); }
+    void addEdge(int u, int v, int w){ ensureVertex(std::max(u,v)); if(!alive[u]||!alive[v]) return; adj[u].emplace_back(v,w); adj[v].emplace_back(u,w); }
+
+    // Removes one u-v edge from both lists in O(deg(u) + deg(v)); the mirror must carry the same weight
+    bool removeEdge(int u, int v){
+        if(u<0||u>=n||v<0||v>=n) return false;
+        auto it=std::find_if(adj[u].begin(),adj[u].end(),[v](const Edge& e){ return e.first==v; });
+        if(it==adj[u].end()) return false;
+        int w=it->second; adj[u].erase(it);
+        auto jt=std::find(adj[v].begin(),adj[v].end(),Edge(u,w)); if(jt!=adj[v].end()) adj[v].erase(jt);
+        return true;
+    }
+
+    // Tombstones u (its ID stays reserved until compact()); only u's neighbours are touched
+    bool removeVertex(int u){
+        if(!isAlive(u)) return false;
+        for(const auto& e:adj[u]){
+            if(e.first==u) continue;
+            auto jt=std::find_if(adj[e.first].begin(),adj[e.first].end(),[u](const Edge& x){ return x.first==u; });
+            if(jt!=adj[e.first].end()) adj[e.first].erase(jt);
+        }
+        std::vector<Edge>().swap(adj[u]); alive[u]=0;
+        return true;
+    }
+
+    bool isAlive(int u) const { return u>=0 && u<n && alive[u]; }
+
+    // Renumbers surviving vertices densely in their original order; returns newId[old] (-1 if removed)
+    std::vector<int> compact(){
+        std::vector<int> newId(n,-1); int next=0;
+        for(int v=0;v<n;++v) if(alive[v]) newId[v]=next++;
+        for(int v=0;v<n;++v){
+            if(newId[v]<0) continue;
+            for(auto& e:adj[v]) e.first=newId[e.first];
+            if(newId[v]!=v) adj[newId[v]].swap(adj[v]);
+        }
+        adj.resize(next); alive.assign(next,1); n=next;
+        return newId;
+    }
 
     int vertexCount() const { return n; }
 
     const std::vector<Edge>& neighbors(int u) const { return adj[u]; }
 
     // BFS/DFS by topology (weights ignored for traversal order)
+    BfsCursor<UndirectedWeightedGraph> bfsCursor(int start) const { return BfsCursor<UndirectedWeightedGraph>(*this, isAlive(start)?start:-1); }
+    BfsCursor<UndirectedWeightedGraph> bfsCursor(int start, TraversalWorkspace& ws) const { return BfsCursor<UndirectedWeightedGraph>(*this, isAlive(start)?start:-1, ws); }
+    DfsCursor<UndirectedWeightedGraph> dfsCursor(int start) const { return DfsCursor<UndirectedWeightedGraph>(*this, isAlive(start)?start:-1); }
+    DfsCursor<UndirectedWeightedGraph> dfsCursor(int start, TraversalWorkspace& ws) const { return DfsCursor<UndirectedWeightedGraph>(*this, isAlive(start)?start:-1, ws); }
+
     std::vector<int> bfs(int start) const {
-        std::vector<int> order; if(start<0||start>=n) return order;
-        std::vector<bool> vis(n,false); std::queue<int> q; q.push(start); vis[start]=true;
-        while(!q.empty()){
-            int u=q.front(); q.pop(); order.push_back(u);
-            for(const auto &e:adj[u]) if(!vis[e.first]){ vis[e.first]=true; q.push(e.first);}    
-        }
+        std::vector<int> order; TraversalStep s;
+        for(auto c=bfsCursor(start); c.next(s);) order.push_back(s.vertex);
         return order;
     }
 
     std::vector<int> dfs(int start) const {
-        std::vector<int> order; if(start<0||start>=n) return order;
-        std::vector<bool> vis(n,false); std::stack<int> st; st.push(start);
-        while(!st.empty()){
-            int u=st.top(); st.pop(); if(vis[u]) continue; vis[u]=true; order.push_back(u);
-            for(int i=(int)adj[u].size()-1;i>=0;--i){ int v=adj[u][i].first; if(!vis[v]) st.push(v);}    
-        }
+        std::vector<int> order; TraversalStep s;
+        for(auto c=dfsCursor(start); c.next(s);) order.push_back(s.vertex);
         return order;
     }
 
@@ -46,6 +80,7 @@ private:
     void ensureVertex(int idx){ while(idx>=n) addVertex(); }
     int n; 
     std::vector<std::vector<Edge>> adj;
+    std::vector<char> alive;
 };
 
 #endif // UNDIRECTED_WEIGHTED_GRAPH_H
@@ -0,0 +1,386 @@
+#ifndef UNIFIED_GRAPH_H
+#define UNIFIED_GRAPH_H
+
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include "EdgeIndex.h"
+#include "Traversal.h"
+
+// Unified graph interface supporting 4 types
+class UnifiedGraph {
+public:
+    enum Type { DirectedUnweighted, DirectedWeighted, UndirectedUnweighted, UndirectedWeighted };
+    
+    struct Edge {
+        int to, weight;
+        Edge(int t, int w = 0) : to(t), weight(w) {}
+    };
+
+    // One entry per mutation, so views (layout, renderer) can replay what changed instead of
+    // rebuilding. VertexRemoved implies all incident edges went with it. Compaction is logged as a
+    // VertexMoved (u -> v) per renumbered vertex in ascending order, then Compacted (u = new count).
+    // WeightChanged carries the merged weight of an existing edge. Reset means every ID may have
+    // changed (clear, permute).
+    struct Change {
+        enum Kind { VertexAdded, VertexRemoved, EdgeAdded, EdgeRemoved, WeightChanged, VertexMoved, Compacted, Reset };
+        Kind kind;
+        int u, v, weight;
+    };
+
+    // What addEdge() does when the edge already exists (needs the edge index). Keep stores a
+    // parallel edge as before; the others fold the new weight into the existing edge.
+    enum class MultiEdgePolicy { Keep, KeepFirst, KeepLast, Sum, Min, Max };
+
+    UnifiedGraph(Type t) : type(t) {}
+
+    int addVertex() {
+        adj.emplace_back();
+        alive.push_back(1);
+        int id = (int)adj.size() - 1;
+        record({Change::VertexAdded, id, -1, 0});
+        return id;
+    }
+
+    // Returns true if a new edge was stored. Edges touching a removed vertex, rejected self-loops
+    // and duplicates merged by the multi-edge policy return false.
+    bool addEdge(int u, int v, int w = 1) {
+        ensureVertex(std::max(u, v));
+        if (!alive[u] || !alive[v]) return false;
+        if (u == v && !selfLoops) return false;
+        if (indexed) {
+            auto [a, b] = indexKey(u, v);
+            if (policy != MultiEdgePolicy::Keep && index.contains(a, b)) {
+                mergeWeight(u, v, w);
+                return false;
+            }
+            index.add(a, b);
+        }
+        adj[u].emplace_back(v, w);
+        if (type == UndirectedUnweighted || type == UndirectedWeighted) {
+            adj[v].emplace_back(u, w);
+        }
+        record({Change::EdgeAdded, u, v, w});
+        return true;
+    }
+
+    // Turns the hashed (u, v) index on or off. Enabling it also folds parallel edges that are
+    // already stored according to `p`, so imported data is normalized in one O(V + E) pass.
+    void setEdgeIndex(bool enabled, MultiEdgePolicy p = MultiEdgePolicy::KeepFirst) {
+        indexed = enabled;
+        policy = p;
+        index.clear();
+        if (!enabled) return;
+        if (policy != MultiEdgePolicy::Keep) mergeParallelEdges();
+        rebuildIndex();
+    }
+
+    bool hasEdgeIndex() const { return indexed; }
+    MultiEdgePolicy multiEdgePolicy() const { return policy; }
+
+    // Disallowing self-loops also removes the ones already stored
+    void setAllowSelfLoops(bool allow) {
+        selfLoops = allow;
+        if (allow) return;
+        for (int u = 0; u < (int)adj.size(); ++u)
+            while (removeEdge(u, u)) {}
+    }
+
+    bool allowsSelfLoops() const { return selfLoops; }
+
+    // O(1) with the edge index, O(deg(u)) otherwise
+    bool hasEdge(int u, int v) const { return edgeMultiplicity(u, v) > 0; }
+
+    // Number of parallel u -> v edges (an undirected self-loop counts once, though stored twice)
+    int edgeMultiplicity(int u, int v) const {
+        if (u < 0 || v < 0 || u >= (int)adj.size() || v >= (int)adj.size()) return 0;
+        if (indexed) {
+            auto [a, b] = indexKey(u, v);
+            return index.count(a, b);
+        }
+        int k = 0;
+        for (const auto& e : adj[u]) k += e.to == v;
+        return (!isDirected() && u == v) ? k / 2 : k;
+    }
+
+    // Removes one u -> v edge (and its mirror when undirected) in O(deg(u) + deg(v)).
+    // Insertion order of the remaining arcs is kept. Returns false if there is no such edge.
+    bool removeEdge(int u, int v) {
+        if (u < 0 || v < 0 || u >= (int)adj.size() || v >= (int)adj.size()) return false;
+        auto& out = adj[u];
+        auto it = std::find_if(out.begin(), out.end(), [v](const Edge& e) { return e.to == v; });
+        if (it == out.end()) return false;
+        int w = it->weight;
+        out.erase(it);
+        if (indexed) {
+            auto [a, b] = indexKey(u, v);
+            index.remove(a, b);
+        }
+        if (!isDirected()) {
+            // A self-loop's mirror sits in the same list
+            auto& back = adj[v];
+            auto jt = std::find_if(back.begin(), back.end(), [u, w](const Edge& e) { return e.to == u && e.weight == w; });
+            if (jt != back.end()) back.erase(jt);
+        }
+        record({Change::EdgeRemoved, u, v, w});
+        return true;
+    }
+
+    // Tombstones u: its ID stays reserved (positions and other per-vertex state stay valid) and
+    // all incident edges are dropped. Undirected graphs only touch u's neighbours; directed graphs
+    // have no reverse index, so incoming arcs cost one O(V + E) sweep.
+    bool removeVertex(int u) {
+        if (!isAlive(u)) return false;
+        if (isDirected()) {
+            for (int x = 0; x < (int)adj.size(); ++x) {
+                auto& list = adj[x];
+                auto cut = std::remove_if(list.begin(), list.end(), [u](const Edge& e) { return e.to == u; });
+                // u's own list included: its self-loops are gone before the loop below reads it
+                if (indexed)
+                    for (auto it = cut; it != list.end(); ++it) index.remove(x, u);
+                list.erase(cut, list.end());
+            }
+            if (indexed)
+                for (const auto& e : adj[u]) index.remove(u, e.to);
+        } else {
+            int loopEntries = 0;
+            for (const auto& e : adj[u]) {
+                if (e.to == u) { ++loopEntries; continue; }
+                auto& back = adj[e.to];
+                auto jt = std::find_if(back.begin(), back.end(), [u](const Edge& x) { return x.to == u; });
+                if (jt != back.end()) back.erase(jt);
+                if (indexed) {
+                    auto [a, b] = indexKey(u, e.to);
+                    index.remove(a, b);
+                }
+            }
+            if (indexed)
+                for (int k = 0; k < loopEntries / 2; ++k) index.remove(u, u);
+        }
+        std::vector<Edge>().swap(adj[u]);
+        alive[u] = 0;
+        ++deadCount;
+        record({Change::VertexRemoved, u, -1, 0});
+        return true;
+    }
+
+    bool isAlive(int u) const { return u >= 0 && u < (int)adj.size() && alive[u]; }
+    int liveVertexCount() const { return (int)adj.size() - deadCount; }
+    int removedVertexCount() const { return deadCount; }
+
+    // Worth compacting once a quarter of the ID space is tombstones
+    bool needsCompaction() const { return deadCount > 0 && deadCount * 4 >= (int)adj.size(); }
+
+    // Drops tombstones and renumbers the survivors densely, keeping their relative order.
+    // Returns newId[old] (-1 for removed vertices).
+    std::vector<int> compact() {
+        int n = (int)adj.size();
+        std::vector<int> newId(n, -1);
+        int next = 0;
+        for (int v = 0; v < n; ++v)
+            if (alive[v]) newId[v] = next++;
+        if (deadCount == 0) return newId;
+        for (int v = 0; v < n; ++v) {
+            if (newId[v] < 0) continue;
+            for (auto& e : adj[v]) e.to = newId[e.to];
+            if (newId[v] != v) {
+                adj[newId[v]].swap(adj[v]);
+                record({Change::VertexMoved, v, newId[v], 0});
+            }
+        }
+        adj.resize(next);
+        alive.assign(next, 1);
+        deadCount = 0;
+        if (indexed) rebuildIndex();
+        record({Change::Compacted, next, -1, 0});
+        return newId;
+    }
+
+    int vertexCount() const { return (int)adj.size(); }
+
+    const std::vector<Edge>& neighbors(int u) const { return adj[u]; }
+
+    void clear() {
+        adj.clear();
+        alive.clear();
+        deadCount = 0;
+        index.clear();
+        record({Change::Reset, -1, -1, 0});
+    }
+
+    // Change log. revision() grows by one per recorded change; only the newest MAX_LOG entries
+    // are kept, so a consumer that fell further behind gets false and must rebuild from scratch.
+    static constexpr size_t MAX_LOG = 4096;
+
+    unsigned long long revision() const { return logStart + log.size(); }
+
+    bool changesSince(unsigned long long rev, std::vector<Change>& out) const {
+        out.clear();
+        if (rev < logStart || rev > revision()) return false;
+        out.assign(log.begin() + (long long)(rev - logStart), log.end());
+        return true;
+    }
+
+    // Pull-based traversals (see Traversal.h): one visit per next(), so callers can stop early.
+    // A dead start yields nothing. Passing a workspace reuses its buffers across traversals.
+    BfsCursor<UnifiedGraph> bfsCursor(int start) const { return BfsCursor<UnifiedGraph>(*this, isAlive(start) ? start : -1); }
+    BfsCursor<UnifiedGraph> bfsCursor(int start, TraversalWorkspace& ws) const { return BfsCursor<UnifiedGraph>(*this, isAlive(start) ? start : -1, ws); }
+    DfsCursor<UnifiedGraph> dfsCursor(int start) const { return DfsCursor<UnifiedGraph>(*this, isAlive(start) ? start : -1); }
+    DfsCursor<UnifiedGraph> dfsCursor(int start, TraversalWorkspace& ws) const { return DfsCursor<UnifiedGraph>(*this, isAlive(start) ? start : -1, ws); }
+
+    std::vector<int> bfs(int start) const {
+        std::vector<int> order;
+        TraversalStep s;
+        for (auto c = bfsCursor(start); c.next(s);) order.push_back(s.vertex);
+        return order;
+    }
+
+    std::vector<int> dfs(int start) const {
+        std::vector<int> order;
+        TraversalStep s;
+        for (auto c = dfsCursor(start); c.next(s);) order.push_back(s.vertex);
+        return order;
+    }
+
+    Type getType() const { return type; }
+
+    bool isDirected() const { return type == DirectedUnweighted || type == DirectedWeighted; }
+    bool isWeighted() const { return type == DirectedWeighted || type == UndirectedWeighted; }
+
+    // Number of stored adjacency entries (undirected edges are counted twice)
+    long long arcCount() const {
+        long long m = 0;
+        for (const auto& list : adj) m += (long long)list.size();
+        return m;
+    }
+
+    // Weight used by path algorithms: unweighted graphs count every edge as 1
+    int effectiveWeight(const Edge& e) const { return isWeighted() ? e.weight : 1; }
+
+    // Relabel vertices: vertex v becomes newId[v]. newId must be a permutation of 0..n-1.
+    // Lists are rebuilt in new-id order so their heap blocks follow the new numbering too.
+    void permute(const std::vector<int>& newId) {
+        int n = (int)adj.size();
+        std::vector<int> oldId(n);
+        for (int v = 0; v < n; ++v) oldId[newId[v]] = v;
+        std::vector<std::vector<Edge>> next(n);
+        for (int nv = 0; nv < n; ++nv) {
+            const auto& src = adj[oldId[nv]];
+            next[nv].reserve(src.size());
+            for (const auto& e : src) next[nv].emplace_back(newId[e.to], e.weight);
+        }
+        adj.swap(next);
+        std::vector<char> moved(n);
+        for (int v = 0; v < n; ++v) moved[newId[v]] = alive[v];
+        alive.swap(moved);
+        if (indexed) rebuildIndex();
+        record({Change::Reset, -1, -1, 0});
+    }
+
+private:
+    void ensureVertex(int idx) {
+        while (idx >= (int)adj.size()) addVertex();
+    }
+
+    std::pair<int, int> indexKey(int u, int v) const {
+        if (isDirected() || u <= v) return {u, v};
+        return {v, u};
+    }
+
+    int combine(int current, int incoming) const {
+        switch (policy) {
+            case MultiEdgePolicy::KeepLast: return incoming;
+            case MultiEdgePolicy::Sum: return current + incoming;
+            case MultiEdgePolicy::Min: return std::min(current, incoming);
+            case MultiEdgePolicy::Max: return std::max(current, incoming);
+            default: return current;
+        }
+    }
+
+    // Folds w into the stored u -> v edge (and its mirror)
+    void mergeWeight(int u, int v, int w) {
+        auto it = std::find_if(adj[u].begin(), adj[u].end(), [v](const Edge& e) { return e.to == v; });
+        if (it == adj[u].end()) return;
+        int old = it->weight, merged = combine(old, w);
+        if (merged == old) return;
+        it->weight = merged;
+        if (!isDirected()) {
+            // For a self-loop the mirror is the next entry to u in the same list
+            auto from = (u == v) ? it + 1 : adj[v].begin();
+            auto jt = std::find_if(from, adj[v].end(), [u, old](const Edge& e) { return e.to == u && e.weight == old; });
+            if (jt != adj[v].end()) jt->weight = merged;
+        }
+        record({Change::WeightChanged, u, v, merged});
+    }
+
+    // Keeps the first arc per target in every list, folding later parallels into it. Both lists of
+    // an undirected edge see its parallels in the same order, so mirrors end up identical.
+    void mergeParallelEdges() {
+        int n = (int)adj.size();
+        std::vector<int> slot(n, -1);
+        std::vector<Edge> kept;
+        for (int u = 0; u < n; ++u) {
+            kept.clear();
+            bool loopMirror = false;
+            for (const auto& e : adj[u]) {
+                // An undirected self-loop is stored as two consecutive entries; fold each pair once
+                if (!isDirected() && e.to == u) {
+                    loopMirror = !loopMirror;
+                    if (!loopMirror) continue;
+                }
+                bool canonical = isDirected() || u <= e.to;
+                if (slot[e.to] < 0) {
+                    slot[e.to] = (int)kept.size();
+                    kept.push_back(e);
+                    continue;
+                }
+                Edge& first = kept[slot[e.to]];
+                int merged = combine(first.weight, e.weight);
+                if (canonical) {
+                    record({Change::EdgeRemoved, u, e.to, e.weight});
+                    if (merged != first.weight) record({Change::WeightChanged, u, e.to, merged});
+                }
+                first.weight = merged;
+            }
+            for (const auto& e : kept) slot[e.to] = -1;
+            adj[u].clear();
+            for (const auto& e : kept) {
+                adj[u].push_back(e);
+                if (!isDirected() && e.to == u) adj[u].push_back(e);
+            }
+        }
+    }
+
+    void rebuildIndex() {
+        index.clear();
+        for (int u = 0; u < (int)adj.size(); ++u) {
+            int loopEntries = 0;
+            for (const auto& e : adj[u]) {
+                if (isDirected()) index.add(u, e.to);
+                else if (e.to == u) { if (++loopEntries % 2 == 1) index.add(u, u); }
+                else if (u < e.to) index.add(u, e.to);
+            }
+        }
+    }
+
+    void record(const Change& c) {
+        log.push_back(c);
+        if (log.size() > MAX_LOG) {
+            log.pop_front();
+            ++logStart;
+        }
+    }
+
+    Type type;
+    std::vector<std::vector<Edge>> adj;
+    std::vector<char> alive;
+    int deadCount{0};
+    bool selfLoops{true};
+    bool indexed{false};
+    MultiEdgePolicy policy{MultiEdgePolicy::Keep};
+    EdgeIndex index;
+    std::deque<Change> log;
+    unsigned long long logStart{0};
+};
+
+#endif // UNIFIED_GRAPH_H
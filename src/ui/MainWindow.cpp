@@ -4,6 +4,7 @@
 #include "../visualizer/StackVisualizer.h"
 #include "../visualizer/QueueVisualizer.h"
 #include "../visualizer/TreeVisualizer.h"
+#include "../visualizer/BPlusTreeVisualizer.h"
 #include "../visualizer/GraphVisualizer.h"
 #include <QTabWidget>
 #include <QIcon>
@@ -51,6 +52,7 @@ MainWindow::MainWindow(QWidget *parent)
     StackVisualizer *stackVis = new StackVisualizer(this);
     QueueVisualizer *queueVis = new QueueVisualizer(this);
     TreeVisualizer *treeVis = new TreeVisualizer(this);
+    BPlusTreeVisualizer *bplusVis = new BPlusTreeVisualizer(this);
     GraphVisualizer *graphVis = new GraphVisualizer(this);
     
     // Add tabs
@@ -59,6 +61,7 @@ MainWindow::MainWindow(QWidget *parent)
     tabWidget->addTab(stackVis, "\U0001F4DA Stack");
     tabWidget->addTab(queueVis, "\U0001F500 Queue");
     tabWidget->addTab(treeVis, "\U0001F333 Tree");
+    tabWidget->addTab(bplusVis, "\U0001F332 B+ Tree");
     tabWidget->addTab(graphVis, "\U0001F30F Graph");
     
     setCentralWidget(tabWidget);
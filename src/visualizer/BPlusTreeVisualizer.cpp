@@ -0,0 +1,469 @@
+#include "BPlusTreeVisualizer.h"
+#include <QPainter>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QInputDialog>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QStringList>
+#include <limits>
+
+// Node geometry in unscaled units: one cell per key
+static const int CELL = 34;
+static const int PAD = 6;
+static const int NODE_H = 32;
+static const int LEVEL_GAP = 80;
+static const int NODE_GAP = 16;
+// Beyond this many boxes the lower levels are left out of the drawing
+static const int MAX_DRAWN = 2000;
+
+static int nodeWidth(const BPlusTree& t, int n) { return std::max(1, t.node(n).count) * CELL + 2 * PAD; }
+
+static const int SAMPLE_KEYS[] = {5, 10, 15, 20, 25, 30, 35, 40, 45, 50, 55, 60, 65, 70, 75, 80};
+
+BPlusTreeVisualizer::BPlusTreeVisualizer(QWidget* parent)
+    : QWidget(parent), tree(4), highlightKey(std::numeric_limits<int>::min()) {
+    tree.bulkLoad(std::vector<int>(std::begin(SAMPLE_KEYS), std::end(SAMPLE_KEYS)));
+
+    QVBoxLayout* main = new QVBoxLayout(this);
+    main->setSpacing(15);
+    main->setContentsMargins(20, 20, 20, 20);
+
+    // Title
+    infoLabel = new QLabel("\xF0\x9F\x8C\xB2 B+ Tree Visualizer"); // 🌲
+    infoLabel->setStyleSheet(
+        "font-size: 22px; font-weight: bold; padding: 10px; "
+        "background: qlineargradient(x1:0, y1:0, x2:1, y2:0, stop:0 #16a085, stop:1 #2980b9); "
+        "border-radius: 8px; color: white;");
+    infoLabel->setAlignment(Qt::AlignCenter);
+    main->addWidget(infoLabel);
+
+    // Stats row
+    QHBoxLayout* stats = new QHBoxLayout();
+    QString statStyle = "font-size: 13px; color: #2c3e50; padding: 6px; background:#ecf0f1; border-radius:5px;";
+    sizeLabel = new QLabel(); sizeLabel->setStyleSheet(statStyle); sizeLabel->setAlignment(Qt::AlignCenter);
+    heightLabel = new QLabel(); heightLabel->setStyleSheet(statStyle); heightLabel->setAlignment(Qt::AlignCenter);
+    nodesLabel = new QLabel(); nodesLabel->setStyleSheet(statStyle); nodesLabel->setAlignment(Qt::AlignCenter);
+    stats->addWidget(sizeLabel);
+    stats->addWidget(heightLabel);
+    stats->addWidget(nodesLabel);
+    main->addLayout(stats);
+
+    // Controls
+    controlGroup = new QGroupBox("Control Panel");
+    controlGroup->setStyleSheet(
+        "QGroupBox { font-size:14px; font-weight:bold; border:2px solid #16a085; border-radius:8px; margin-top:10px; padding-top:10px; }"
+        "QGroupBox::title { left: 15px; padding: 0 5px; color:#16a085; }");
+    QVBoxLayout* gl = new QVBoxLayout();
+
+    QString labelStyle = "font-size:12px; font-weight:bold; color:#2c3e50;";
+    QString inputStyle = "padding:8px; border:2px solid #bdc3c7; border-radius:5px; font-size:12px;";
+    QHBoxLayout* inputs = new QHBoxLayout();
+    QLabel* valueLbl = new QLabel("Value:"); valueLbl->setStyleSheet(labelStyle);
+    valueInput = new QLineEdit(); valueInput->setPlaceholderText("Enter integer value");
+    valueInput->setMaximumWidth(180); valueInput->setStyleSheet(inputStyle);
+    QLabel* rangeLbl = new QLabel("Range:"); rangeLbl->setStyleSheet(labelStyle);
+    fromInput = new QLineEdit(); fromInput->setPlaceholderText("from"); fromInput->setMaximumWidth(90); fromInput->setStyleSheet(inputStyle);
+    toInput = new QLineEdit(); toInput->setPlaceholderText("to"); toInput->setMaximumWidth(90); toInput->setStyleSheet(inputStyle);
+    QLabel* fanoutLbl = new QLabel("Fanout:"); fanoutLbl->setStyleSheet(labelStyle);
+    fanoutSpin = new QSpinBox(); fanoutSpin->setRange(3, 16); fanoutSpin->setValue(tree.fanout());
+    fanoutSpin->setToolTip("Most children per inner node; every node holds up to fanout - 1 keys");
+    fanoutSpin->setStyleSheet("padding:6px; border:2px solid #bdc3c7; border-radius:5px; font-size:12px;");
+    inputs->addWidget(valueLbl); inputs->addWidget(valueInput);
+    inputs->addSpacing(20);
+    inputs->addWidget(rangeLbl); inputs->addWidget(fromInput); inputs->addWidget(toInput);
+    inputs->addSpacing(20);
+    inputs->addWidget(fanoutLbl); inputs->addWidget(fanoutSpin);
+    inputs->addStretch();
+    gl->addLayout(inputs);
+
+    QString btnStyle =
+        "QPushButton { padding:10px 20px; font-size:13px; font-weight:bold; border:none; border-radius:6px; color:white; background-color:%1; }"
+        "QPushButton:hover { background-color:%2; }"
+        "QPushButton:pressed { background-color:%3; }";
+
+    QHBoxLayout* row1 = new QHBoxLayout();
+    insertBtn = new QPushButton("➕ Insert"); insertBtn->setStyleSheet(btnStyle.arg("#27ae60", "#229954", "#1e8449"));
+    deleteBtn = new QPushButton("❌ Delete"); deleteBtn->setStyleSheet(btnStyle.arg("#e74c3c", "#c0392b", "#a93226"));
+    searchBtn = new QPushButton("🔍 Search"); searchBtn->setStyleSheet(btnStyle.arg("#3498db", "#2980b9", "#21618c"));
+    rangeBtn = new QPushButton("↔ Range scan"); rangeBtn->setStyleSheet(btnStyle.arg("#f39c12", "#e67e22", "#d68910"));
+    clearBtn = new QPushButton("🗑 Clear"); clearBtn->setStyleSheet(btnStyle.arg("#95a5a6", "#7f8c8d", "#5d6d7e"));
+    reloadBtn = new QPushButton("🔄 Reload"); reloadBtn->setStyleSheet(btnStyle.arg("#3498db", "#2980b9", "#21618c"));
+    pasteBtn = new QPushButton("📋 Bulk load"); pasteBtn->setStyleSheet(btnStyle.arg("#34495e", "#2c3e50", "#212f3d"));
+    row1->addWidget(insertBtn); row1->addWidget(deleteBtn); row1->addWidget(searchBtn); row1->addWidget(rangeBtn);
+    row1->addWidget(clearBtn); row1->addWidget(reloadBtn); row1->addWidget(pasteBtn);
+    gl->addLayout(row1);
+
+    controlGroup->setLayout(gl);
+    main->addWidget(controlGroup);
+
+    statusLabel = new QLabel("✅ Ready - B+ tree bulk-loaded with sample data");
+    statusLabel->setStyleSheet("font-size:13px; color:#27ae60; padding:10px; background:#d5f4e6; border-left:4px solid #27ae60; border-radius:5px;");
+    main->addWidget(statusLabel);
+    main->addStretch();
+
+    connect(insertBtn, &QPushButton::clicked, this, &BPlusTreeVisualizer::onInsert);
+    connect(deleteBtn, &QPushButton::clicked, this, &BPlusTreeVisualizer::onDelete);
+    connect(searchBtn, &QPushButton::clicked, this, &BPlusTreeVisualizer::onSearch);
+    connect(rangeBtn, &QPushButton::clicked, this, &BPlusTreeVisualizer::onRangeScan);
+    connect(clearBtn, &QPushButton::clicked, this, &BPlusTreeVisualizer::onClear);
+    connect(reloadBtn, &QPushButton::clicked, this, &BPlusTreeVisualizer::onReload);
+    connect(pasteBtn, &QPushButton::clicked, this, &BPlusTreeVisualizer::onPasteKeys);
+    connect(fanoutSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &BPlusTreeVisualizer::onFanoutChanged);
+
+    scanTimer = new QTimer(this);
+    scanTimer->setInterval(350);
+    connect(scanTimer, &QTimer::timeout, this, [this]() {
+        if (scanIndex >= (int)scanKeys.size()) { stopScan(); update(); return; }
+        highlightKey = scanKeys[scanIndex++];
+        update();
+    });
+
+    morphTimer = new QTimer(this);
+    morphTimer->setInterval(30);
+    connect(morphTimer, &QTimer::timeout, this, [this]() {
+        morphT = std::min(1.0, morphT + 0.08);
+        if (morphT >= 1.0) {
+            morphTimer->stop();
+            morphFrom.clear();
+            touchedNodes.clear();
+        }
+        update();
+    });
+
+    updateStatus(statusLabel->text(), "success");
+}
+
+void BPlusTreeVisualizer::paintEvent(QPaintEvent* e) { QWidget::paintEvent(e); drawTree(); }
+
+QRect BPlusTreeVisualizer::treeArea() const {
+    int controlsBottom = 0;
+    if (statusLabel && statusLabel->isVisible()) controlsBottom = statusLabel->geometry().bottom();
+    if (controlGroup && controlGroup->isVisible() && controlGroup->geometry().bottom() > controlsBottom)
+        controlsBottom = controlGroup->geometry().bottom();
+    int topOffset = std::max(controlsBottom + 20, 140);
+    int drawHeight = std::max(80, height() - topOffset - 30);
+    int drawWidth = std::max(100, width() - 80);
+    return QRect(40, topOffset, drawWidth, drawHeight);
+}
+
+// Node boxes in widget coordinates, keyed by node index. Each level is laid out from the one
+// below: the bottom drawn level is packed left to right and every inner node is centred over
+// its first and last child, so the leaf chain reads as one sorted row.
+std::unordered_map<int, QRectF> BPlusTreeVisualizer::computeLayout(double& scale, int& hiddenNodes) const {
+    std::unordered_map<int, QRectF> rects;
+    scale = 1.0;
+    hiddenNodes = 0;
+    if (tree.root() == BPlusTree::NIL) return rects;
+
+    std::vector<std::vector<int>> levels{{tree.root()}};
+    int drawn = 1;
+    while (!tree.node(levels.back()[0]).leaf) {
+        std::vector<int> below;
+        for (int n : levels.back())
+            for (int i = 0; i <= tree.node(n).count; ++i) below.push_back(tree.child(n, i));
+        if (drawn + (int)below.size() > MAX_DRAWN) break;
+        drawn += (int)below.size();
+        levels.push_back(std::move(below));
+    }
+    hiddenNodes = tree.nodeCount() - drawn;
+
+    // Unscaled layout
+    double x = 0;
+    for (int n : levels.back()) {
+        rects[n] = QRectF(x, (levels.size() - 1) * (NODE_H + LEVEL_GAP), nodeWidth(tree, n), NODE_H);
+        x += nodeWidth(tree, n) + NODE_GAP;
+    }
+    double totalWidth = std::max(1.0, x - NODE_GAP);
+    for (int l = (int)levels.size() - 2; l >= 0; --l) {
+        for (int n : levels[l]) {
+            double centre = (rects[tree.child(n, 0)].center().x() + rects[tree.child(n, tree.node(n).count)].center().x()) / 2;
+            rects[n] = QRectF(centre - nodeWidth(tree, n) / 2.0, l * (NODE_H + LEVEL_GAP), nodeWidth(tree, n), NODE_H);
+        }
+    }
+    double totalHeight = levels.size() * (NODE_H + LEVEL_GAP) - LEVEL_GAP;
+
+    QRect area = treeArea();
+    scale = std::min({1.0, (area.width() - 20) / totalWidth, (area.height() - 40) / totalHeight});
+    scale = std::max(0.1, scale);
+    double left = area.left() + std::max(10.0, (area.width() - totalWidth * scale) / 2);
+    double top = area.top() + 20;
+    for (auto& entry : rects) {
+        const QRectF& r = entry.second;
+        entry.second = QRectF(left + r.x() * scale, top + r.y() * scale, r.width() * scale, r.height() * scale);
+    }
+    return rects;
+}
+
+void BPlusTreeVisualizer::drawTree() {
+    QPainter p(this); p.setRenderHint(QPainter::Antialiasing);
+    QRect area = treeArea();
+
+    if (tree.root() == BPlusTree::NIL) {
+        p.setPen(QPen(QColor("#95a5a6"), 2)); p.setFont(QFont("Arial", 16, QFont::Bold));
+        p.drawText(area, Qt::AlignCenter, "⚠️ Tree is empty\n\nInsert or bulk-load keys to build the B+ tree");
+        return;
+    }
+
+    double scale;
+    int hidden;
+    std::unordered_map<int, QRectF> rects = computeLayout(scale, hidden);
+    if (morphT < 1.0) {
+        double t = 1.0 - (1.0 - morphT) * (1.0 - morphT); // ease out
+        for (auto& entry : rects) {
+            auto from = morphFrom.find(entry.first);
+            if (from == morphFrom.end()) continue;
+            QRectF a = from->second, b = entry.second;
+            entry.second = QRectF(a.topLeft() + (b.topLeft() - a.topLeft()) * t, b.size());
+        }
+    }
+    p.setClipRect(area);
+
+    // Child links leave the parent between the separators that bound the child's keys
+    p.setPen(QPen(QColor("#7f8c8d"), std::max(1.0, 2 * scale)));
+    for (const auto& entry : rects) {
+        int n = entry.first;
+        if (tree.node(n).leaf) continue;
+        const QRectF& r = entry.second;
+        for (int i = 0; i <= tree.node(n).count; ++i) {
+            auto child = rects.find(tree.child(n, i));
+            if (child == rects.end()) continue;
+            QPointF from(r.left() + (PAD + i * CELL) * scale, r.bottom());
+            p.drawLine(from, QPointF(child->second.center().x(), child->second.top()));
+        }
+    }
+
+    // Leaf chain
+    p.setPen(QPen(QColor("#16a085"), std::max(1.0, 2 * scale), Qt::DashLine));
+    for (const auto& entry : rects) {
+        const BPlusTree::Node& n = tree.node(entry.first);
+        if (!n.leaf || n.next == BPlusTree::NIL) continue;
+        auto next = rects.find(n.next);
+        if (next == rects.end()) continue;
+        QPointF a(entry.second.right(), entry.second.center().y()), b(next->second.left(), next->second.center().y());
+        p.drawLine(a, b);
+        p.drawLine(b, b + QPointF(-6 * scale, -4 * scale));
+        p.drawLine(b, b + QPointF(-6 * scale, 4 * scale));
+    }
+
+    for (const auto& entry : rects) drawNode(p, entry.first, entry.second, scale);
+
+    if (hidden > 0) {
+        p.setPen(QColor("#7f8c8d")); p.setFont(QFont("Arial", 11, QFont::Bold));
+        p.drawText(area.adjusted(0, 0, 0, -6), Qt::AlignBottom | Qt::AlignHCenter,
+                   QString::number(hidden) + " lower-level nodes not drawn");
+    }
+}
+
+void BPlusTreeVisualizer::drawNode(QPainter& p, int node, const QRectF& rect, double scale) {
+    const BPlusTree::Node& n = tree.node(node);
+    int w = nodeWidth(tree, node);
+    bool touched = touchedNodes.count(node) > 0;
+    bool onPath = std::find(pathNodes.begin(), pathNodes.end(), node) != pathNodes.end();
+    QColor fill = n.leaf ? QColor("#2ecc71") : QColor("#3498db");
+    QColor border = n.leaf ? QColor("#27ae60") : QColor("#2980b9");
+    if (onPath) border = QColor("#8e44ad");
+    if (touched) border = QColor("#e67e22");
+
+    p.save();
+    p.translate(rect.topLeft());
+    p.scale(scale, scale);
+
+    // Shadow
+    p.setBrush(QColor(0,0,0,35)); p.setPen(Qt::NoPen);
+    p.drawRoundedRect(QRectF(3, 3, w, NODE_H), 6, 6);
+
+    p.setBrush(fill); p.setPen(QPen(border, touched || onPath ? 4 : 2));
+    p.drawRoundedRect(QRectF(0, 0, w, NODE_H), 6, 6);
+
+    // One cell per key
+    p.setFont(QFont("Arial", 11, QFont::Bold));
+    for (int i = 0; i < n.count; ++i) {
+        QRectF cell(PAD + i * CELL, 3, CELL, NODE_H - 6);
+        int k = tree.key(node, i);
+        if (n.leaf && k == highlightKey) {
+            p.setPen(Qt::NoPen); p.setBrush(scanTimer->isActive() ? QColor("#f39c12") : QColor("#e74c3c"));
+            p.drawRoundedRect(cell.adjusted(1, 0, -1, 0), 4, 4);
+        }
+        if (i > 0) {
+            p.setPen(QPen(QColor(255, 255, 255, 140), 1));
+            p.drawLine(QPointF(cell.left(), 5), QPointF(cell.left(), NODE_H - 5));
+        }
+        p.setPen(Qt::white);
+        p.drawText(cell, Qt::AlignCenter, QString::number(k));
+    }
+    p.restore();
+}
+
+// Remembers where every node is drawn now; call before changing the tree
+void BPlusTreeVisualizer::beginMorph() {
+    double scale;
+    int hidden;
+    morphFrom = computeLayout(scale, hidden);
+}
+
+void BPlusTreeVisualizer::startMorph() {
+    touchedNodes.clear();
+    for (const BPlusTree::Event& e : tree.lastEvents()) {
+        touchedNodes.insert(e.node);
+        if (e.kind == BPlusTree::Event::Split || e.kind == BPlusTree::Event::Borrow) touchedNodes.insert(e.other);
+        // New nodes grow out of the node they were split from (a new root out of the old root)
+        if ((e.kind == BPlusTree::Event::Split || e.kind == BPlusTree::Event::NewRoot)) {
+            int fresh = e.kind == BPlusTree::Event::Split ? e.other : e.node;
+            int source = e.kind == BPlusTree::Event::Split ? e.node : e.other;
+            auto from = morphFrom.find(source);
+            if (from != morphFrom.end()) morphFrom[fresh] = from->second;
+        }
+    }
+    morphT = 0.0;
+    morphTimer->start();
+    update();
+}
+
+QString BPlusTreeVisualizer::describeEvents() const {
+    int splits = 0, merges = 0, borrows = 0;
+    bool grew = false, shrank = false;
+    for (const BPlusTree::Event& e : tree.lastEvents()) {
+        switch (e.kind) {
+        case BPlusTree::Event::Split: ++splits; break;
+        case BPlusTree::Event::Merge: ++merges; break;
+        case BPlusTree::Event::Borrow: ++borrows; break;
+        case BPlusTree::Event::NewRoot: grew = true; break;
+        case BPlusTree::Event::ShrinkRoot: shrank = true; break;
+        }
+    }
+    QStringList parts;
+    if (splits) parts << QString::number(splits) + (splits == 1 ? " split" : " splits");
+    if (borrows) parts << "borrowed from a sibling";
+    if (merges) parts << QString::number(merges) + (merges == 1 ? " merge" : " merges");
+    if (grew) parts << "new root";
+    if (shrank) parts << "root removed";
+    return parts.isEmpty() ? QString() : " | " + parts.join(", ");
+}
+
+void BPlusTreeVisualizer::stopScan() {
+    scanTimer->stop();
+    scanKeys.clear();
+    scanIndex = 0;
+}
+
+void BPlusTreeVisualizer::updateStatus(const QString& m, const QString& kind) {
+    if (kind == "success") {
+        statusLabel->setStyleSheet("font-size:13px; color:#27ae60; padding:10px; background:#d5f4e6; border-left:4px solid #27ae60; border-radius:5px;");
+    } else if (kind == "error") {
+        statusLabel->setStyleSheet("font-size:13px; color:#e74c3c; padding:10px; background:#fadbd8; border-left:4px solid #e74c3c; border-radius:5px;");
+    } else {
+        statusLabel->setStyleSheet("font-size:13px; color:#3498db; padding:10px; background:#d6eaf8; border-left:4px solid #3498db; border-radius:5px;");
+    }
+    statusLabel->setText(m);
+    sizeLabel->setText("Keys: " + QString::number(tree.size()));
+    heightLabel->setText("Height: " + QString::number(tree.height()));
+    nodesLabel->setText("Nodes: " + QString::number(tree.nodeCount()) + " | up to " + QString::number(tree.fanout() - 1) + " keys each");
+}
+
+void BPlusTreeVisualizer::onInsert() {
+    bool ok; int v = valueInput->text().toInt(&ok);
+    if (!ok || valueInput->text().isEmpty()) { updateStatus("Please enter a valid integer value", "error"); return; }
+    stopScan(); pathNodes.clear();
+    beginMorph();
+    if (!tree.insert(v)) { morphFrom.clear(); updateStatus("Value already exists in tree", "error"); return; }
+    highlightKey = v; valueInput->clear(); updateStatus("Inserted " + QString::number(v) + describeEvents(), "success"); startMorph();
+}
+
+void BPlusTreeVisualizer::onDelete() {
+    bool ok; int v = valueInput->text().toInt(&ok);
+    if (!ok || valueInput->text().isEmpty()) { updateStatus("Please enter a valid integer value", "error"); return; }
+    stopScan(); pathNodes.clear();
+    beginMorph();
+    if (!tree.remove(v)) { morphFrom.clear(); updateStatus("Value not found in tree", "error"); return; }
+    highlightKey = std::numeric_limits<int>::min(); updateStatus("Deleted " + QString::number(v) + describeEvents(), "success"); startMorph();
+}
+
+void BPlusTreeVisualizer::onSearch() {
+    bool ok; int v = valueInput->text().toInt(&ok);
+    if (!ok || valueInput->text().isEmpty()) { updateStatus("Please enter a valid integer to search", "error"); return; }
+    stopScan();
+    pathNodes = tree.searchPath(v);
+    QString levels = " (" + QString::number(pathNodes.size()) + " nodes visited)";
+    if (tree.contains(v)) { highlightKey = v; updateStatus("Found value " + QString::number(v) + levels, "success"); }
+    else { highlightKey = std::numeric_limits<int>::min(); updateStatus("Value not found" + levels, "error"); }
+    update();
+}
+
+void BPlusTreeVisualizer::onRangeScan() {
+    bool okFrom, okTo;
+    int lo = fromInput->text().toInt(&okFrom), hi = toInput->text().toInt(&okTo);
+    if (!okFrom || !okTo) { updateStatus("Enter integer bounds for the range", "error"); return; }
+    if (lo > hi) std::swap(lo, hi);
+    stopScan();
+    pathNodes = tree.searchPath(lo);
+    scanKeys = tree.range(lo, hi);
+
+    // Leaves the scan touches: the one lo lands in, then along the chain until a key passes hi
+    int leaves = 0;
+    for (int n = pathNodes.empty() ? BPlusTree::NIL : pathNodes.back(); n != BPlusTree::NIL; n = tree.node(n).next) {
+        ++leaves;
+        if (tree.node(n).count > 0 && tree.key(n, tree.node(n).count - 1) >= hi) break;
+    }
+    QString summary = "Range [" + QString::number(lo) + ", " + QString::number(hi) + "]: " + QString::number(scanKeys.size()) +
+                      " keys from " + QString::number(leaves) + (leaves == 1 ? " leaf" : " chained leaves");
+    if (scanKeys.empty() || scanKeys.size() > 200) {
+        scanKeys.clear();
+        highlightKey = std::numeric_limits<int>::min();
+        updateStatus(summary, "info");
+    } else {
+        updateStatus(summary + " - scanning…", "info");
+        scanTimer->start();
+    }
+    update();
+}
+
+void BPlusTreeVisualizer::onClear() {
+    if (tree.size() == 0) { updateStatus("Tree is already empty", "info"); return; }
+    stopScan(); pathNodes.clear(); touchedNodes.clear(); morphTimer->stop(); morphFrom.clear();
+    tree.clear(); highlightKey = std::numeric_limits<int>::min(); updateStatus("Cleared all keys", "success"); update();
+}
+
+void BPlusTreeVisualizer::onReload() {
+    stopScan(); pathNodes.clear(); touchedNodes.clear(); morphTimer->stop(); morphFrom.clear();
+    tree.bulkLoad(std::vector<int>(std::begin(SAMPLE_KEYS), std::end(SAMPLE_KEYS)));
+    highlightKey = std::numeric_limits<int>::min();
+    updateStatus("B+ tree reloaded with sample data", "success");
+    update();
+}
+
+void BPlusTreeVisualizer::onPasteKeys() {
+    bool ok;
+    QString text = QInputDialog::getMultiLineText(this, "Bulk load", "Integers separated by spaces, commas or new lines:", QString(), &ok);
+    if (!ok) return;
+    std::vector<int> keys;
+    int skipped = 0;
+    const auto tokens = text.split(QRegularExpression("[\\s,;]+"), Qt::SkipEmptyParts);
+    for (const QString& token : tokens) {
+        bool isInt; int v = token.toInt(&isInt);
+        if (isInt) keys.push_back(v); else ++skipped;
+    }
+    if (keys.empty()) { updateStatus("No integers found in pasted text", "error"); return; }
+
+    stopScan(); pathNodes.clear(); touchedNodes.clear(); morphTimer->stop(); morphFrom.clear();
+    highlightKey = std::numeric_limits<int>::min();
+    QElapsedTimer timer; timer.start();
+    int kept = tree.bulkLoad(std::move(keys));
+    QString msg = "Bulk-loaded " + QString::number(kept) + " keys in " + QString::number(timer.elapsed()) +
+                  " ms into " + QString::number(tree.nodeCount()) + " nodes, height " + QString::number(tree.height());
+    if (skipped > 0) msg += " | " + QString::number(skipped) + " invalid tokens skipped";
+    updateStatus(msg, "success");
+    update();
+}
+
+// A different fanout means a different tree shape; rebuild the current keys bottom-up
+void BPlusTreeVisualizer::onFanoutChanged(int fanout) {
+    if (fanout == tree.fanout()) return;
+    stopScan(); pathNodes.clear(); touchedNodes.clear(); morphTimer->stop(); morphFrom.clear();
+    std::vector<int> keys = tree.keys();
+    tree = BPlusTree(fanout);
+    tree.bulkLoad(std::move(keys));
+    updateStatus("Fanout " + QString::number(fanout) + ": " + QString::number(tree.nodeCount()) + " nodes, height " +
+                 QString::number(tree.height()), "success");
+    update();
+}
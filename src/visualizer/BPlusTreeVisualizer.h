@@ -0,0 +1,82 @@
+#ifndef BPLUSTREEVISUALIZER_H
+#define BPLUSTREEVISUALIZER_H
+
+#include <QWidget>
+#include <QPushButton>
+#include <QLineEdit>
+#include <QLabel>
+#include <QGroupBox>
+#include <QTimer>
+#include <QSpinBox>
+#include <QRectF>
+#include <unordered_map>
+#include <unordered_set>
+#include "../ds/BPlusTree.h"
+
+class BPlusTreeVisualizer : public QWidget {
+    Q_OBJECT
+public:
+    explicit BPlusTreeVisualizer(QWidget* parent = nullptr);
+
+private slots:
+    void onInsert();
+    void onDelete();
+    void onSearch();
+    void onClear();
+    void onReload();
+    void onPasteKeys();
+    void onRangeScan();
+    void onFanoutChanged(int fanout);
+
+private:
+    void paintEvent(QPaintEvent* event) override;
+    void drawTree();
+    void drawNode(class QPainter& p, int node, const QRectF& rect, double scale);
+    std::unordered_map<int, QRectF> computeLayout(double& scale, int& hiddenNodes) const;
+    QRect treeArea() const;
+    void beginMorph();
+    void startMorph();
+    QString describeEvents() const;
+    void stopScan();
+    void updateStatus(const QString& message, const QString& kind);
+
+    BPlusTree tree;
+
+    // UI
+    QLineEdit* valueInput;
+    QLineEdit* fromInput;
+    QLineEdit* toInput;
+    QSpinBox* fanoutSpin;
+    QPushButton* insertBtn;
+    QPushButton* deleteBtn;
+    QPushButton* searchBtn;
+    QPushButton* clearBtn;
+    QPushButton* reloadBtn;
+    QPushButton* pasteBtn;
+    QPushButton* rangeBtn;
+    QLabel* statusLabel;
+    QLabel* infoLabel;
+    QLabel* sizeLabel;
+    QLabel* heightLabel;
+    QLabel* nodesLabel;
+    QGroupBox* controlGroup;
+
+    // Search: nodes on the root-to-leaf path and the key found, if any
+    std::vector<int> pathNodes;
+    int highlightKey;
+
+    // Range scan animation along the leaf chain
+    QTimer* scanTimer{nullptr};
+    std::vector<int> scanKeys;
+    int scanIndex{0};
+
+    // Change animation: node boxes glide from where they were drawn before the last insert/remove
+    // (a split's new sibling starts on top of the node it came from); nodes that split, merged or
+    // borrowed are outlined until it ends
+    QTimer* morphTimer{nullptr};
+    std::unordered_map<int, QRectF> morphFrom;
+    double morphT{1.0};
+    std::unordered_set<int> touchedNodes;
+};
+
+#endif // BPLUSTREEVISUALIZER_H
@@ -0,0 +1,150 @@
+#include "GraphGeneratorDialog.h"
+#include <QFormLayout>
+#include <QVBoxLayout>
+#include <QDialogButtonBox>
+#include <cmath>
+
+GraphGeneratorDialog::GraphGeneratorDialog(long long vertexLimit, long long edgeLimit, QWidget* parent)
+    : QDialog(parent), vertexLimit(vertexLimit), edgeLimit(edgeLimit) {
+    setWindowTitle("Generate Graph");
+    QVBoxLayout* main = new QVBoxLayout(this);
+    QFormLayout* form = new QFormLayout();
+
+    // Item order matches GraphGenerators::Model
+    modelCombo = new QComboBox();
+    modelCombo->addItem("R-MAT (skewed, power-law)");
+    modelCombo->addItem("Erdős–Rényi G(n, p)");
+    modelCombo->addItem("Barabási–Albert (preferential attachment)");
+    modelCombo->addItem("Grid / torus");
+    modelCombo->addItem("Random geometric");
+    form->addRow("Model:", modelCombo);
+
+    seedSpin = new QSpinBox();
+    seedSpin->setRange(0, 2147483647);
+    seedSpin->setValue(1);
+    form->addRow("Seed:", seedSpin);
+
+    verticesSpin = new QSpinBox();
+    verticesSpin->setRange(1, 50000000);
+    verticesSpin->setValue(1000);
+    verticesSpin->setSingleStep(1000);
+    form->addRow("Vertices:", verticesSpin);
+
+    scaleSpin = new QSpinBox();
+    scaleSpin->setRange(1, 26);
+    scaleSpin->setValue(10);
+    scaleSpin->setPrefix("2^");
+    form->addRow("Scale:", scaleSpin);
+
+    edgeFactorSpin = new QSpinBox();
+    edgeFactorSpin->setRange(1, 256);
+    edgeFactorSpin->setValue(8);
+    form->addRow("Edges per vertex:", edgeFactorSpin);
+
+    probabilitySpin = new QDoubleSpinBox();
+    probabilitySpin->setDecimals(6);
+    probabilitySpin->setRange(0.0, 1.0);
+    probabilitySpin->setSingleStep(0.001);
+    probabilitySpin->setValue(0.01);
+    form->addRow("Edge probability:", probabilitySpin);
+
+    radiusSpin = new QDoubleSpinBox();
+    radiusSpin->setDecimals(4);
+    radiusSpin->setRange(0.0001, 1.0);
+    radiusSpin->setSingleStep(0.01);
+    radiusSpin->setValue(0.05);
+    form->addRow("Radius:", radiusSpin);
+
+    rowsSpin = new QSpinBox();
+    rowsSpin->setRange(1, 10000);
+    rowsSpin->setValue(32);
+    colsSpin = new QSpinBox();
+    colsSpin->setRange(1, 10000);
+    colsSpin->setValue(32);
+    form->addRow("Rows:", rowsSpin);
+    form->addRow("Columns:", colsSpin);
+    wrapCheck = new QCheckBox("Wrap around (torus)");
+    form->addRow("", wrapCheck);
+
+    directedCheck = new QCheckBox("Directed");
+    form->addRow("", directedCheck);
+    maxWeightSpin = new QSpinBox();
+    maxWeightSpin->setRange(0, 1000000);
+    maxWeightSpin->setValue(0);
+    maxWeightSpin->setSpecialValueText("unweighted");
+    form->addRow("Max weight:", maxWeightSpin);
+    main->addLayout(form);
+
+    estimateLabel = new QLabel();
+    estimateLabel->setStyleSheet("font-size:11px; color:#2c3e50; padding:6px; background:#ecf0f1; border-radius:4px;");
+    main->addWidget(estimateLabel);
+
+    QDialogButtonBox* buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    okButton = buttons->button(QDialogButtonBox::Ok);
+    main->addWidget(buttons);
+
+    connect(buttons, &QDialogButtonBox::accepted, this, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+    connect(modelCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &GraphGeneratorDialog::onModelChanged);
+    for (QSpinBox* spin : {verticesSpin, scaleSpin, edgeFactorSpin, rowsSpin, colsSpin})
+        connect(spin, QOverload<int>::of(&QSpinBox::valueChanged), this, &GraphGeneratorDialog::onModelChanged);
+    for (QDoubleSpinBox* spin : {probabilitySpin, radiusSpin})
+        connect(spin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &GraphGeneratorDialog::onModelChanged);
+    connect(directedCheck, &QCheckBox::toggled, this, &GraphGeneratorDialog::onModelChanged);
+    connect(wrapCheck, &QCheckBox::toggled, this, &GraphGeneratorDialog::onModelChanged);
+    onModelChanged();
+}
+
+void GraphGeneratorDialog::onModelChanged() {
+    using Model = GraphGenerators::Model;
+    Model m = (Model)modelCombo->currentIndex();
+    verticesSpin->setEnabled(m == Model::ErdosRenyi || m == Model::BarabasiAlbert || m == Model::RandomGeometric);
+    scaleSpin->setEnabled(m == Model::RMAT);
+    edgeFactorSpin->setEnabled(m == Model::RMAT || m == Model::BarabasiAlbert);
+    probabilitySpin->setEnabled(m == Model::ErdosRenyi);
+    radiusSpin->setEnabled(m == Model::RandomGeometric);
+    rowsSpin->setEnabled(m == Model::Grid);
+    colsSpin->setEnabled(m == Model::Grid);
+    wrapCheck->setEnabled(m == Model::Grid);
+    seedSpin->setEnabled(m != Model::Grid);
+
+    // Expected size, so a multi-million edge request is not a surprise, and one the canvas cannot
+    // hold is not generated at all
+    GraphGenerators::Estimate e = GraphGenerators::estimate(spec());
+    QString text = "≈ " + QString::number(e.vertices, 'f', 0) + " vertices, ≈ " + QString::number(e.edges, 'f', 0) +
+                   " edges | " + QString::number(Parallel::threadCount()) + " thread(s)";
+    QString over = overCanvasLimit(e, vertexLimit, edgeLimit);
+    bool fits = over.isEmpty();
+    if (!fits) text += "\n" + over + " - use bench/graph_gen_bench for larger graphs";
+    estimateLabel->setText(text);
+    estimateLabel->setStyleSheet(fits ? "font-size:11px; color:#2c3e50; padding:6px; background:#ecf0f1; border-radius:4px;"
+                                      : "font-size:11px; color:#c0392b; padding:6px; background:#fadbd8; border-radius:4px;");
+    okButton->setEnabled(fits);
+}
+
+QString GraphGeneratorDialog::overCanvasLimit(const GraphGenerators::Estimate& e, long long vertexLimit, long long edgeLimit) {
+    if (e.vertices > vertexLimit)
+        return "≈ " + QString::number(e.vertices, 'f', 0) + " vertices requested - over the " + QString::number(vertexLimit) +
+               "-vertex canvas limit";
+    if (e.edges > edgeLimit)
+        return "≈ " + QString::number(e.edges, 'f', 0) + " edges requested - over the " + QString::number(edgeLimit) +
+               "-edge canvas limit";
+    return QString();
+}
+
+GraphGenerators::Spec GraphGeneratorDialog::spec() const {
+    GraphGenerators::Spec s;
+    s.model = (GraphGenerators::Model)modelCombo->currentIndex();
+    s.seed = (uint64_t)seedSpin->value();
+    s.directed = directedCheck->isChecked();
+    s.maxWeight = maxWeightSpin->value();
+    s.vertices = verticesSpin->value();
+    s.scale = scaleSpin->value();
+    s.edgeFactor = edgeFactorSpin->value();
+    s.probability = probabilitySpin->value();
+    s.radius = radiusSpin->value();
+    s.rows = rowsSpin->value();
+    s.cols = colsSpin->value();
+    s.wrap = wrapCheck->isChecked();
+    return s;
+}
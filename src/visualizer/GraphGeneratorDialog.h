@@ -0,0 +1,46 @@
+#ifndef GRAPHGENERATORDIALOG_H
+#define GRAPHGENERATORDIALOG_H
+
+#include <QDialog>
+#include <QComboBox>
+#include <QSpinBox>
+#include <QDoubleSpinBox>
+#include <QCheckBox>
+#include <QLabel>
+#include <QPushButton>
+#include "../algo/GraphGenerators.h"
+
+// Parameter form for GraphGenerators; only the fields the chosen model uses are enabled, and OK
+// stays disabled while the expected vertex or edge count is over its canvas limit
+class GraphGeneratorDialog : public QDialog {
+    Q_OBJECT
+public:
+    GraphGeneratorDialog(long long vertexLimit, long long edgeLimit, QWidget* parent = nullptr);
+
+    GraphGenerators::Spec spec() const;
+
+    // Why an estimate does not fit the canvas, naming the count that is over; empty when it fits
+    static QString overCanvasLimit(const GraphGenerators::Estimate& e, long long vertexLimit, long long edgeLimit);
+
+private slots:
+    void onModelChanged();
+
+private:
+    QComboBox* modelCombo;
+    QSpinBox* seedSpin;
+    QSpinBox* verticesSpin;
+    QSpinBox* scaleSpin;
+    QSpinBox* edgeFactorSpin;
+    QDoubleSpinBox* probabilitySpin;
+    QDoubleSpinBox* radiusSpin;
+    QSpinBox* rowsSpin, *colsSpin;
+    QCheckBox* wrapCheck;
+    QCheckBox* directedCheck;
+    QSpinBox* maxWeightSpin;
+    QLabel* estimateLabel;
+    QPushButton* okButton;
+    long long vertexLimit;
+    long long edgeLimit;
+};
+
+#endif // GRAPHGENERATORDIALOG_H
@@ -1,4 +1,5 @@
 #include "GraphVisualizer.h"
+#include "GraphGeneratorDialog.h"
 #include <QPainter>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -8,6 +9,7 @@
 #include <algorithm>
 #include <limits>
 #include <QRandomGenerator>
+#include <QElapsedTimer>
 
 GraphVisualizer::GraphVisualizer(QWidget* parent)
     : QWidget(parent), graph(UnifiedGraph::DirectedUnweighted) {
@@ -91,6 +93,13 @@ GraphVisualizer::GraphVisualizer(QWidget* parent)
         "QPushButton:checked { background: #3498db; color: white; border-color: #2980b9; }"
     );
     toggleLayoutBtn->setMinimumHeight(34);
+    onionBtn = new QPushButton("🧅 Onion");
+    onionBtn->setCheckable(true);
+    onionBtn->setStyleSheet(
+        "QPushButton { padding: 8px 14px; font-size: 12px; font-weight: bold; border: 2px solid #d35400; border-radius: 6px; color: #2c3e50; background: #fbeee6; }"
+        "QPushButton:checked { background: #d35400; color: white; border-color: #ba4a00; }"
+    );
+    onionBtn->setMinimumHeight(34);
     fitViewBtn = new QPushButton("Fit");
     fitViewBtn->setStyleSheet(
         "QPushButton { padding: 8px 14px; font-size: 12px; font-weight: bold; border: 2px solid #16a085; border-radius: 6px; color: #2c3e50; background: #e8f8f5; }"
@@ -109,16 +118,48 @@ GraphVisualizer::GraphVisualizer(QWidget* parent)
     addVertexBtn = new QPushButton("➕ Add");
     addVertexBtn->setStyleSheet(btnStyle.arg("#27ae60", "#229954", "#1e8449"));
     addVertexBtn->setMinimumHeight(34);
+    removeVertexInput = new QLineEdit();
+    removeVertexInput->setPlaceholderText("ID");
+    removeVertexInput->setMaximumWidth(50);
+    removeVertexInput->setMinimumHeight(32);
+    removeVertexInput->setStyleSheet("padding:8px; border:2px solid #bdc3c7; border-radius:5px; font-size:12px;");
+    removeVertexBtn = new QPushButton("➖ Remove");
+    removeVertexBtn->setStyleSheet(btnStyle.arg("#7f8c8d", "#707b7c", "#616a6b"));
+    removeVertexBtn->setMinimumHeight(34);
+
+    QLabel* parallelLbl = new QLabel("Parallel:");
+    parallelLbl->setStyleSheet("font-size:11px; font-weight:bold; color:#2c3e50;");
+    edgePolicyCombo = new QComboBox();
+    edgePolicyCombo->addItem("Keep all");
+    edgePolicyCombo->addItem("Keep first");
+    edgePolicyCombo->addItem("Keep last");
+    edgePolicyCombo->addItem("Sum");
+    edgePolicyCombo->addItem("Min");
+    edgePolicyCombo->addItem("Max");
+    edgePolicyCombo->setMinimumHeight(32);
+    edgePolicyCombo->setStyleSheet(
+        "QComboBox { padding: 6px 10px; border: 2px solid #8e44ad; border-radius: 6px; "
+        "font-size: 12px; font-weight: bold; color: #2c3e50; background: white; }");
+    selfLoopsCheck = new QCheckBox("Loops");
+    selfLoopsCheck->setChecked(true);
+    selfLoopsCheck->setStyleSheet("font-size:11px; font-weight:bold; color:#2c3e50;");
     
     line1->addWidget(typeLbl);
     line1->addWidget(typeCombo);
     line1->addSpacing(10);
     line1->addWidget(toggleLayoutBtn);
+    line1->addWidget(onionBtn);
     line1->addWidget(fitViewBtn);
     line1->addSpacing(10);
     line1->addWidget(vLbl);
     line1->addWidget(vertexInput);
     line1->addWidget(addVertexBtn);
+    line1->addWidget(removeVertexInput);
+    line1->addWidget(removeVertexBtn);
+    line1->addSpacing(10);
+    line1->addWidget(parallelLbl);
+    line1->addWidget(edgePolicyCombo);
+    line1->addWidget(selfLoopsCheck);
     line1->addStretch();
     gl->addLayout(line1);
 
@@ -145,6 +186,9 @@ GraphVisualizer::GraphVisualizer(QWidget* parent)
     addEdgeBtn = new QPushButton("➕ Add");
     addEdgeBtn->setStyleSheet(btnStyle.arg("#e74c3c", "#c0392b", "#a93226"));
     addEdgeBtn->setMinimumHeight(34);
+    removeEdgeBtn = new QPushButton("➖ Remove");
+    removeEdgeBtn->setStyleSheet(btnStyle.arg("#7f8c8d", "#707b7c", "#616a6b"));
+    removeEdgeBtn->setMinimumHeight(34);
     
     QLabel* searchLbl = new QLabel("Search:");
     searchLbl->setStyleSheet("font-size:11px; font-weight:bold; color:#2c3e50;");
@@ -162,10 +206,28 @@ GraphVisualizer::GraphVisualizer(QWidget* parent)
     line2->addWidget(edgeV);
     line2->addWidget(edgeW);
     line2->addWidget(addEdgeBtn);
+    line2->addWidget(removeEdgeBtn);
     line2->addSpacing(10);
     line2->addWidget(searchLbl);
     line2->addWidget(searchVertexInput);
     line2->addWidget(searchVertexBtn);
+    line2->addSpacing(10);
+    QLabel* reorderLbl = new QLabel("Relabel:");
+    reorderLbl->setStyleSheet("font-size:11px; font-weight:bold; color:#2c3e50;");
+    reorderCombo = new QComboBox();
+    reorderCombo->addItem("Reverse Cuthill-McKee");
+    reorderCombo->addItem("Degree descending");
+    reorderCombo->addItem("Gorder");
+    reorderCombo->setMinimumHeight(32);
+    reorderCombo->setStyleSheet(
+        "QComboBox { padding: 6px 10px; border: 2px solid #16a085; border-radius: 6px; "
+        "font-size: 12px; font-weight: bold; color: #2c3e50; background: white; }");
+    reorderBtn = new QPushButton("↕ Apply");
+    reorderBtn->setStyleSheet(btnStyle.arg("#16a085", "#138d75", "#117a65"));
+    reorderBtn->setMinimumHeight(34);
+    line2->addWidget(reorderLbl);
+    line2->addWidget(reorderCombo);
+    line2->addWidget(reorderBtn);
     line2->addStretch();
     gl->addLayout(line2);
     
@@ -186,20 +248,142 @@ GraphVisualizer::GraphVisualizer(QWidget* parent)
     playBFSBtn->setStyleSheet(btnStyle.arg("#2ecc71", "#27ae60", "#1e8449"));
     playDFSBtn = new QPushButton("▶ Play DFS");
     playDFSBtn->setStyleSheet(btnStyle.arg("#1abc9c", "#16a085", "#138d75"));
+    matrixBtn = new QPushButton("🧮 Distances");
+    matrixBtn->setCheckable(true);
+    matrixBtn->setStyleSheet(btnStyle.arg("#34495e", "#2c3e50", "#1b2631") +
+        "QPushButton:checked { background-color:#e67e22; }");
+    compactBtn = new QPushButton("🗜 Compact");
+    compactBtn->setCheckable(true);
+    compactBtn->setStyleSheet(btnStyle.arg("#7f8c8d", "#707b7c", "#616a6b") +
+        "QPushButton:checked { background-color:#e67e22; }");
+    generateBtn = new QPushButton("🎲 Generate");
+    generateBtn->setStyleSheet(btnStyle.arg("#16a085", "#138d75", "#117a65"));
     clearBtn->setMinimumHeight(34);
     bfsBtn->setMinimumHeight(34);
     dfsBtn->setMinimumHeight(34);
     playBFSBtn->setMinimumHeight(34);
     playDFSBtn->setMinimumHeight(34);
+    matrixBtn->setMinimumHeight(34);
+    compactBtn->setMinimumHeight(34);
+    generateBtn->setMinimumHeight(34);
     line3->addWidget(clearBtn);
     line3->addWidget(reloadBtn);
     line3->addWidget(bfsBtn);
     line3->addWidget(dfsBtn);
     line3->addWidget(playBFSBtn);
     line3->addWidget(playDFSBtn);
+    line3->addWidget(matrixBtn);
+    line3->addWidget(compactBtn);
+    line3->addWidget(generateBtn);
     line3->addStretch();
     gl->addLayout(line3);
 
+    // LINE 4: Analytics - map node scores onto size and colour
+    QHBoxLayout* line4 = new QHBoxLayout();
+    QString metricComboStyle =
+        "QComboBox { padding: 6px 10px; border: 2px solid #8e44ad; border-radius: 6px; "
+        "font-size: 12px; font-weight: bold; color: #2c3e50; background: white; }"
+        "QComboBox:hover { background: #f4ecf7; }";
+    QLabel* sizeLbl = new QLabel("Size by:");
+    sizeLbl->setStyleSheet("font-size:11px; font-weight:bold; color:#2c3e50;");
+    sizeMetricCombo = new QComboBox();
+    QLabel* colorLbl = new QLabel("Colour by:");
+    colorLbl->setStyleSheet("font-size:11px; font-weight:bold; color:#2c3e50;");
+    colorMetricCombo = new QComboBox();
+    for (QComboBox* combo : {sizeMetricCombo, colorMetricCombo}) {
+        combo->addItem("Uniform");
+        combo->addItem("Degree");
+        combo->addItem("PageRank");
+        combo->addItem("Betweenness");
+        combo->addItem("Clustering");
+        combo->addItem("Core number");
+        combo->setMinimumWidth(130);
+        combo->setMinimumHeight(32);
+        combo->setStyleSheet(metricComboStyle);
+    }
+    line4->addWidget(sizeLbl);
+    line4->addWidget(sizeMetricCombo);
+    line4->addSpacing(10);
+    line4->addWidget(colorLbl);
+    line4->addWidget(colorMetricCombo);
+    line4->addSpacing(10);
+    QLabel* communityLbl = new QLabel("Communities:");
+    communityLbl->setStyleSheet("font-size:11px; font-weight:bold; color:#2c3e50;");
+    communityCombo = new QComboBox();
+    communityCombo->addItem("Off");
+    communityCombo->addItem("Label propagation");
+    communityCombo->addItem("Louvain");
+    communityCombo->setMinimumWidth(150);
+    communityCombo->setMinimumHeight(32);
+    communityCombo->setStyleSheet(metricComboStyle);
+    overviewBtn = new QPushButton("🔭 Overview");
+    overviewBtn->setCheckable(true);
+    overviewBtn->setStyleSheet(btnStyle.arg("#27ae60", "#229954", "#1e8449") +
+        "QPushButton:checked { background-color:#e67e22; }");
+    overviewBtn->setMinimumHeight(34);
+    line4->addWidget(communityLbl);
+    line4->addWidget(communityCombo);
+    line4->addWidget(overviewBtn);
+    line4->addSpacing(10);
+    QLabel* coloringLbl = new QLabel("Colouring:");
+    coloringLbl->setStyleSheet("font-size:11px; font-weight:bold; color:#2c3e50;");
+    coloringCombo = new QComboBox();
+    coloringCombo->addItem("Off");
+    coloringCombo->addItem("Smallest-last");
+    coloringCombo->addItem("Jones–Plassmann");
+    coloringCombo->setMinimumWidth(140);
+    coloringCombo->setMinimumHeight(32);
+    coloringCombo->setStyleSheet(metricComboStyle);
+    line4->addWidget(coloringLbl);
+    line4->addWidget(coloringCombo);
+    line4->addSpacing(10);
+    trianglesBtn = new QPushButton("🔺 Triangles");
+    trianglesBtn->setStyleSheet(btnStyle.arg("#8e44ad", "#7d3c98", "#6c3483"));
+    trianglesBtn->setMinimumHeight(34);
+    line4->addWidget(trianglesBtn);
+    line4->addSpacing(10);
+    QLabel* flowLbl = new QLabel("Flow:");
+    flowLbl->setStyleSheet("font-size:11px; font-weight:bold; color:#2c3e50;");
+    flowSourceInput = new QLineEdit();
+    flowSourceInput->setPlaceholderText("s");
+    flowSinkInput = new QLineEdit();
+    flowSinkInput->setPlaceholderText("t");
+    for (QLineEdit* input : {flowSourceInput, flowSinkInput}) {
+        input->setMaximumWidth(45);
+        input->setMinimumHeight(32);
+        input->setStyleSheet("padding:8px; border:2px solid #bdc3c7; border-radius:5px; font-size:12px;");
+    }
+    // Item order matches MaxFlow::Method
+    flowMethodCombo = new QComboBox();
+    flowMethodCombo->addItem("Push-relabel");
+    flowMethodCombo->addItem("Dinic");
+    flowMethodCombo->setMinimumHeight(32);
+    flowMethodCombo->setStyleSheet(metricComboStyle);
+    maxFlowBtn = new QPushButton("💧 Max Flow");
+    maxFlowBtn->setCheckable(true);
+    maxFlowBtn->setStyleSheet(btnStyle.arg("#2980b9", "#2471a3", "#1f618d") +
+        "QPushButton:checked { background-color:#e67e22; }");
+    maxFlowBtn->setMinimumHeight(34);
+    line4->addWidget(flowLbl);
+    line4->addWidget(flowSourceInput);
+    line4->addWidget(flowSinkInput);
+    line4->addWidget(flowMethodCombo);
+    line4->addWidget(maxFlowBtn);
+    compareFlowBtn = new QPushButton("⏱ Compare");
+    compareFlowBtn->setToolTip("Time push-relabel against Dinic once on the current source and sink");
+    compareFlowBtn->setStyleSheet(btnStyle.arg("#2980b9", "#2471a3", "#1f618d"));
+    compareFlowBtn->setMinimumHeight(34);
+    line4->addWidget(compareFlowBtn);
+    matchingBtn = new QPushButton("🔗 Matching");
+    matchingBtn->setCheckable(true);
+    matchingBtn->setStyleSheet(btnStyle.arg("#d35400", "#ba4a00", "#a04000") +
+        "QPushButton:checked { background-color:#e67e22; }");
+    matchingBtn->setMinimumHeight(34);
+    line4->addSpacing(10);
+    line4->addWidget(matchingBtn);
+    line4->addStretch();
+    gl->addLayout(line4);
+
     controlGroup->setLayout(gl);
     main->addWidget(controlGroup);
 
@@ -211,6 +395,10 @@ GraphVisualizer::GraphVisualizer(QWidget* parent)
     connect(typeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &GraphVisualizer::onTypeChanged);
     connect(addVertexBtn, &QPushButton::clicked, this, &GraphVisualizer::onAddVertex);
     connect(addEdgeBtn, &QPushButton::clicked, this, &GraphVisualizer::onAddEdge);
+    connect(removeVertexBtn, &QPushButton::clicked, this, &GraphVisualizer::onRemoveVertex);
+    connect(removeEdgeBtn, &QPushButton::clicked, this, &GraphVisualizer::onRemoveEdge);
+    connect(edgePolicyCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &GraphVisualizer::onEdgePolicyChanged);
+    connect(selfLoopsCheck, &QCheckBox::toggled, this, &GraphVisualizer::onEdgePolicyChanged);
     connect(reloadBtn, &QPushButton::clicked, this, &GraphVisualizer::onReload);
     connect(clearBtn, &QPushButton::clicked, this, &GraphVisualizer::onClear);
     connect(searchVertexBtn, &QPushButton::clicked, this, &GraphVisualizer::onSearchVertex);
@@ -219,13 +407,29 @@ GraphVisualizer::GraphVisualizer(QWidget* parent)
     connect(playBFSBtn, &QPushButton::clicked, this, &GraphVisualizer::onPlayBFS);
     connect(playDFSBtn, &QPushButton::clicked, this, &GraphVisualizer::onPlayDFS);
     connect(toggleLayoutBtn, &QPushButton::clicked, this, &GraphVisualizer::onToggleLayoutMode);
+    connect(onionBtn, &QPushButton::clicked, this, &GraphVisualizer::onToggleOnionLayout);
     connect(fitViewBtn, &QPushButton::clicked, this, &GraphVisualizer::onFitView);
+    connect(matrixBtn, &QPushButton::clicked, this, &GraphVisualizer::onToggleDistanceMatrix);
+    connect(compactBtn, &QPushButton::clicked, this, &GraphVisualizer::onToggleCompactAdjacency);
+    connect(sizeMetricCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &GraphVisualizer::onMetricMappingChanged);
+    connect(colorMetricCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &GraphVisualizer::onMetricMappingChanged);
+    connect(communityCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &GraphVisualizer::onCommunityModeChanged);
+    connect(overviewBtn, &QPushButton::clicked, this, &GraphVisualizer::onToggleOverview);
+    connect(coloringCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &GraphVisualizer::onColoringChanged);
+    connect(trianglesBtn, &QPushButton::clicked, this, &GraphVisualizer::onCountTriangles);
+    connect(maxFlowBtn, &QPushButton::clicked, this, &GraphVisualizer::onToggleMaxFlow);
+    connect(flowMethodCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &GraphVisualizer::onFlowMethodChanged);
+    connect(compareFlowBtn, &QPushButton::clicked, this, &GraphVisualizer::onCompareMaxFlow);
+    connect(matchingBtn, &QPushButton::clicked, this, &GraphVisualizer::onToggleMatching);
+    connect(reorderBtn, &QPushButton::clicked, this, &GraphVisualizer::onReorderVertices);
+    connect(generateBtn, &QPushButton::clicked, this, &GraphVisualizer::onGenerateGraph);
 }
 
 void GraphVisualizer::onTypeChanged(int idx) {
     UnifiedGraph::Type newType = (UnifiedGraph::Type)idx;
     if (newType != graph.getType()) {
         graph = UnifiedGraph(newType);
+        applyEdgePolicy();
         nodePositions.clear();
         selectedStart = -1;
         
@@ -275,6 +479,7 @@ void GraphVisualizer::onTypeChanged(int idx) {
         }
         
             computeLayout(); // Ensure layout is updated
+        invalidateAnalytics();
         update();
     }
 }
@@ -286,17 +491,18 @@ void GraphVisualizer::onAddVertex() {
         updateStatus("Enter a positive integer for vertex count.", "error");
         return;
     }
-    int currentCount = graph.vertexCount();
+    int currentCount = graph.liveVertexCount();
     if (currentCount + count > 30) {
         int allowedCount = 30 - currentCount;
         updateStatus("❌ Graph node limit reached (max 30). Can only add " + QString::number(allowedCount) + " more node(s).", "error");
         return;
     }
-    int startIdx = currentCount;
+    int startIdx = graph.vertexCount();
     for (int i = 0; i < count; i++) {
         graph.addVertex();
     }
-    computeLayout();
+    applyGraphChanges();
+    invalidateAnalytics();
     updateStatus("Added " + QString::number(count) + " vertices (IDs " + QString::number(startIdx) + "-" + QString::number(startIdx + count - 1) + ")", "success");
     update();
 }
@@ -306,7 +512,7 @@ void GraphVisualizer::onAddEdge() {
     int u = edgeU->text().toInt(&okU);
     int v = edgeV->text().toInt(&okV);
     
-    if (!okU || !okV || u < 0 || v < 0 || u >= graph.vertexCount() || v >= graph.vertexCount()) {
+    if (!okU || !okV || !graph.isAlive(u) || !graph.isAlive(v)) {
         updateStatus("Invalid edge: check vertex IDs.", "error");
         return;
     }
@@ -324,9 +530,16 @@ void GraphVisualizer::onAddEdge() {
         }
     }
     
-    graph.addEdge(u, v, w);
+    if (u == v && !graph.allowsSelfLoops()) {
+        updateStatus("Self-loops are disabled - tick 'Loops' to allow them.", "error");
+        return;
+    }
+    bool added = graph.addEdge(u, v, w);
     
-    if (isWeighted) {
+    if (!added) {
+        updateStatus("Edge " + QString::number(u) + " → " + QString::number(v) + " already exists - merged (" +
+                     edgePolicyCombo->currentText() + ")", "info");
+    } else if (isWeighted) {
         updateStatus("Edge added: " + QString::number(u) + " → " + QString::number(v) + " (w=" + QString::number(w) + ")", "success");
     } else {
         updateStatus("Edge added: " + QString::number(u) + " → " + QString::number(v), "success");
@@ -337,7 +550,88 @@ void GraphVisualizer::onAddEdge() {
     if (isWeighted) {
         edgeW->setText("1");
     }
-    computeLayout(); // Ensure layout is updated
+    applyGraphChanges();
+    invalidateAnalytics();
+    update();
+}
+
+// The edge index is only needed when duplicates are merged; "Keep all" is the plain adjacency lists
+void GraphVisualizer::applyEdgePolicy() {
+    int choice = edgePolicyCombo->currentIndex();
+    if (choice <= 0) graph.setEdgeIndex(false);
+    else graph.setEdgeIndex(true, (UnifiedGraph::MultiEdgePolicy)choice);
+    graph.setAllowSelfLoops(selfLoopsCheck->isChecked());
+}
+
+void GraphVisualizer::onEdgePolicyChanged() {
+    long long before = graph.arcCount();
+    QElapsedTimer timer;
+    timer.start();
+    applyEdgePolicy();
+    qint64 us = timer.nsecsElapsed() / 1000;
+    long long dropped = before - graph.arcCount();
+    applyGraphChanges();
+    invalidateAnalytics();
+    QString msg = "Parallel edges: " + edgePolicyCombo->currentText() + (selfLoopsCheck->isChecked() ? ", loops allowed" : ", no loops");
+    if (dropped > 0) msg += " | folded " + QString::number(dropped) + " stored arcs in " + QString::number(us) + " µs";
+    updateStatus(msg, "success");
+    update();
+}
+
+void GraphVisualizer::onRemoveEdge() {
+    bool okU, okV;
+    int u = edgeU->text().toInt(&okU);
+    int v = edgeV->text().toInt(&okV);
+    if (!okU || !okV || !graph.isAlive(u) || !graph.isAlive(v)) {
+        updateStatus("Invalid edge: check vertex IDs.", "error");
+        return;
+    }
+    if (!graph.removeEdge(u, v)) {
+        updateStatus("No edge " + QString::number(u) + " → " + QString::number(v) + " to remove.", "error");
+        return;
+    }
+    edgeU->clear();
+    edgeV->clear();
+    applyGraphChanges();
+    invalidateAnalytics();
+    updateStatus("Edge removed: " + QString::number(u) + " → " + QString::number(v), "success");
+    update();
+}
+
+void GraphVisualizer::onRemoveVertex() {
+    bool ok;
+    int u = removeVertexInput->text().toInt(&ok);
+    if (!ok || !graph.isAlive(u)) {
+        updateStatus("Enter the ID of an existing vertex to remove.", "error");
+        return;
+    }
+    stopTraversalAnimation();
+    graph.removeVertex(u);
+    QString msg = "Vertex " + QString::number(u) + " removed";
+
+    // Tombstones keep IDs stable; once a quarter of them are dead, renumber the survivors
+    std::vector<int> newId;
+    if (graph.needsCompaction()) {
+        newId = graph.compact();
+        msg += " | compacted IDs to 0-" + QString::number(graph.vertexCount() - 1);
+    }
+    auto remap = [&](int& v) {
+        if (v == u) v = -1;
+        else if (v >= 0 && v < (int)newId.size()) v = newId[v];
+    };
+    remap(selectedStart);
+    remap(highlightedVertex);
+    remap(flowSource);
+    remap(flowSink);
+    if (showFlow && (flowSource < 0 || flowSink < 0)) {
+        showFlow = false;
+        maxFlowBtn->setChecked(false);
+    }
+
+    removeVertexInput->clear();
+    applyGraphChanges();
+    invalidateAnalytics();
+    updateStatus(msg, "success");
     update();
 }
 
@@ -349,6 +643,7 @@ void GraphVisualizer::onClear() {
     graph.clear();
     nodePositions.clear();
     selectedStart = -1;
+    invalidateAnalytics();
     updateStatus("Graph cleared.", "success");
     update();
 }
@@ -369,99 +664,132 @@ void GraphVisualizer::onReload() {
     graph.addEdge(4, 5);
     
     computeLayout();
+    invalidateAnalytics();
     updateStatus("Graph reloaded with sample data", "success");
     update();
 }
 
 void GraphVisualizer::onBFS() {
-    if (graph.vertexCount() == 0) {
+    int start = traversalStart();
+    if (start < 0) {
         updateStatus("Graph is empty.", "error");
         return;
     }
-    int start = (selectedStart >= 0 && selectedStart < graph.vertexCount()) ? selectedStart : 0;
-    auto seq = graph.bfs(start);
-    QString result = "BFS from " + QString::number(start) + ": [";
-    for (size_t i = 0; i < seq.size(); i++) {
-        if (i > 0) result += ", ";
-        result += QString::number(seq[i]);
-    }
-    result += "]";
-    updateStatus(result, "info");
+    auto seq = useCompact ? compactGraph.bfs(start) : graph.bfs(start);
+    updateStatus(formatSequence("BFS", start, seq), "info");
     update();
 }
 
 void GraphVisualizer::onDFS() {
-    if (graph.vertexCount() == 0) {
+    int start = traversalStart();
+    if (start < 0) {
         updateStatus("Graph is empty.", "error");
         return;
     }
-    int start = (selectedStart >= 0 && selectedStart < graph.vertexCount()) ? selectedStart : 0;
-    auto seq = graph.dfs(start);
-    QString result = "DFS from " + QString::number(start) + ": [";
-    for (size_t i = 0; i < seq.size(); i++) {
+    auto seq = useCompact ? compactGraph.dfs(start) : graph.dfs(start);
+    updateStatus(formatSequence("DFS", start, seq), "info");
+    update();
+}
+
+// The selected vertex if it is still there, else the lowest live ID; -1 when no vertex is left
+int GraphVisualizer::traversalStart() const {
+    if (graph.isAlive(selectedStart)) return selectedStart;
+    for (int u = 0; u < graph.vertexCount(); ++u)
+        if (graph.isAlive(u)) return u;
+    return -1;
+}
+
+// Long visit orders (generated graphs) are cut after the first entries to keep the status line readable
+QString GraphVisualizer::formatSequence(const QString& label, int start, const std::vector<int>& seq, long long total) const {
+    const size_t shown = 60;
+    if (total < 0) total = (long long)seq.size();
+    QString result = label + " from " + QString::number(start) + ": [";
+    for (size_t i = 0; i < seq.size() && i < shown; i++) {
         if (i > 0) result += ", ";
         result += QString::number(seq[i]);
     }
+    if (total > (long long)shown) result += ", … +" + QString::number(total - (long long)shown) + " more";
     result += "]";
-    updateStatus(result, "info");
-    update();
+    return result;
 }
 
-void GraphVisualizer::startTraversalAnimation(const std::vector<int>& seq, const QString& label) {
-    if (traversalTimer) {
-        traversalTimer->stop();
-        traversalTimer->deleteLater();
-        traversalTimer = nullptr;
-    }
-    traversalSeq = seq;
-    traversalIndex = 0;
-    if (traversalSeq.empty()) {
+void GraphVisualizer::startTraversalAnimation(std::function<bool(TraversalStep&)> next, const QString& name, int start) {
+    stopTraversalAnimation();
+    QString label = name + " from " + QString::number(start);
+    TraversalStep step;
+    if (!next(step)) {
         updateStatus(label + ": [empty]", "info");
         selectedStart = -1;
         update();
         return;
     }
+    traversalNext = std::move(next);
+    traversalPrefix.assign(1, step.vertex);
+    traversalVisits = 1;
+    selectedStart = step.vertex;
     updateStatus("Animating " + label + "...", "info");
+    update();
+
+    // Each tick pulls one visit; nothing beyond the current frontier is computed ahead
+    const size_t shown = 60;
     traversalTimer = new QTimer(this);
     traversalTimer->setInterval(600);
-    connect(traversalTimer, &QTimer::timeout, this, [this, label]() {
-        if (traversalIndex >= (int)traversalSeq.size()) {
-            traversalTimer->stop();
-            QString result = label + ": [";
-            for (size_t i = 0; i < traversalSeq.size(); i++) {
-                if (i > 0) result += ", ";
-                result += QString::number(traversalSeq[i]);
-            }
-            result += "]";
-            statusLabel->setText(result);
+    connect(traversalTimer, &QTimer::timeout, this, [this, name, start, label, shown]() {
+        TraversalStep step;
+        if (!traversalNext(step)) {
+            std::vector<int> prefix;
+            prefix.swap(traversalPrefix);
+            long long visits = traversalVisits;
+            stopTraversalAnimation();
+            statusLabel->setText(formatSequence(name, start, prefix, visits));
             selectedStart = -1;
             update();
             return;
         }
-        selectedStart = traversalSeq[traversalIndex++];
+        ++traversalVisits;
+        if (traversalPrefix.size() < shown) traversalPrefix.push_back(step.vertex);
+        selectedStart = step.vertex;
+        statusLabel->setText(label + ": visit " + QString::number(step.vertex) + " (parent " +
+                             (step.parent >= 0 ? QString::number(step.parent) : QString("-")) + ", depth " +
+                             QString::number(step.depth) + ", " + QString::number(step.edgesExamined) + " edges examined)");
         update();
     });
     traversalTimer->start();
 }
 
+void GraphVisualizer::stopTraversalAnimation() {
+    if (traversalTimer) {
+        traversalTimer->stop();
+        traversalTimer->deleteLater();
+        traversalTimer = nullptr;
+    }
+    traversalNext = nullptr;
+    traversalPrefix.clear();
+    traversalVisits = 0;
+}
+
 void GraphVisualizer::onPlayBFS() {
-    if (graph.vertexCount() == 0) {
+    int start = traversalStart();
+    if (start < 0) {
         updateStatus("Graph is empty.", "error");
         return;
     }
-    int start = 0;
-    auto seq = graph.bfs(start);
-    startTraversalAnimation(seq, "BFS from " + QString::number(start));
+    std::function<bool(TraversalStep&)> next;
+    if (useCompact) next = [c = compactGraph.bfsCursor(start)](TraversalStep& s) mutable { return c.next(s); };
+    else next = [c = graph.bfsCursor(start)](TraversalStep& s) mutable { return c.next(s); };
+    startTraversalAnimation(std::move(next), "BFS", start);
 }
 
 void GraphVisualizer::onPlayDFS() {
-    if (graph.vertexCount() == 0) {
+    int start = traversalStart();
+    if (start < 0) {
         updateStatus("Graph is empty.", "error");
         return;
     }
-    int start = 0;
-    auto seq = graph.dfs(start);
-    startTraversalAnimation(seq, "DFS from " + QString::number(start));
+    std::function<bool(TraversalStep&)> next;
+    if (useCompact) next = [c = compactGraph.dfsCursor(start)](TraversalStep& s) mutable { return c.next(s); };
+    else next = [c = graph.dfsCursor(start)](TraversalStep& s) mutable { return c.next(s); };
+    startTraversalAnimation(std::move(next), "DFS", start);
 }
 
 void GraphVisualizer::onSearchVertex() {
@@ -475,7 +803,7 @@ void GraphVisualizer::onSearchVertex() {
         return;
     }
     
-    if (vertexId < 0 || vertexId >= graph.vertexCount()) {
+    if (!graph.isAlive(vertexId)) {
         updateStatus("Vertex ID " + QString::number(vertexId) + " not found (valid range: 0-" + 
                     QString::number(graph.vertexCount() - 1) + ")", "error");
         highlightedVertex = -1;
@@ -489,13 +817,140 @@ void GraphVisualizer::onSearchVertex() {
     update();
 }
 
+void GraphVisualizer::onReorderVertices() {
+    int n = graph.vertexCount();
+    if (n == 0) {
+        updateStatus("Graph is empty.", "error");
+        return;
+    }
+    stopTraversalAnimation(); // the running cursor holds old IDs
+
+    QElapsedTimer timer;
+    timer.start();
+    CSRGraph before = CSRGraph::freeze(graph);
+    auto strategy = (GraphReordering::Strategy)reorderCombo->currentIndex();
+    std::vector<int> newId = GraphReordering::compute(before, strategy);
+    graph.permute(newId);
+    double ms = timer.nsecsElapsed() / 1e6;
+
+    // Carry every per-vertex piece of view state over to the new IDs
+    if ((int)nodePositions.size() == n) {
+        std::vector<NodePos> moved(n);
+        for (int v = 0; v < n; ++v) moved[newId[v]] = nodePositions[v];
+        nodePositions.swap(moved);
+    }
+    auto remap = [&](int& v) { if (v >= 0 && v < n) v = newId[v]; };
+    remap(selectedStart);
+    remap(highlightedVertex);
+    remap(flowSource);
+    remap(flowSink);
+    layoutRevision = graph.revision(); // positions were carried over above
+    invalidateAnalytics();
+
+    long long oldBandwidth = GraphReordering::bandwidth(before, GraphReordering::identity(n));
+    long long newBandwidth = GraphReordering::bandwidth(CSRGraph::freeze(graph), GraphReordering::identity(n));
+    updateStatus("Relabelled " + QString::number(n) + " vertices with " + reorderCombo->currentText() + " in " +
+                 QString::number(ms, 'f', 2) + " ms | bandwidth " + QString::number(oldBandwidth) + " → " +
+                 QString::number(newBandwidth), "success");
+    update();
+}
+
+void GraphVisualizer::onGenerateGraph() {
+    GraphGeneratorDialog dialog(CANVAS_VERTEX_LIMIT, CANVAS_EDGE_LIMIT, this);
+    if (dialog.exec() != QDialog::Accepted) return;
+    // The dialog already refuses these; checked again because generating first could exhaust memory
+    QString over = GraphGeneratorDialog::overCanvasLimit(GraphGenerators::estimate(dialog.spec()), CANVAS_VERTEX_LIMIT, CANVAS_EDGE_LIMIT);
+    if (!over.isEmpty()) {
+        updateStatus(over + ", nothing generated", "error");
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    GraphGenerators::EdgeBuffer buffer = GraphGenerators::generate(dialog.spec());
+    double genMs = timer.nsecsElapsed() / 1e6;
+    timer.restart();
+    CSRGraph csr = buffer.toCSR();
+    double csrMs = timer.nsecsElapsed() / 1e6;
+    int maxDegree = 0;
+    for (int u = 0; u < csr.vertexCount(); u++) maxDegree = std::max(maxDegree, csr.degree(u));
+
+    QString msg = "Generated " + QString::number(buffer.n) + " vertices, " + QString::number(buffer.edgeCount()) +
+                  " edges in " + QString::number(genMs, 'f', 1) + " ms on " + QString::number(Parallel::threadCount()) +
+                  " thread(s) | CSR " + QString::number(csrMs, 'f', 1) + " ms, max degree " + QString::number(maxDegree);
+    if (buffer.n > CANVAS_VERTEX_LIMIT) {
+        updateStatus(msg + " | over the " + QString::number(CANVAS_VERTEX_LIMIT) + "-vertex canvas limit, current graph kept", "info");
+        return;
+    }
+    if (buffer.edgeCount() > CANVAS_EDGE_LIMIT) {
+        updateStatus(msg + " | over the " + QString::number(CANVAS_EDGE_LIMIT) + "-edge canvas limit, current graph kept", "info");
+        return;
+    }
+    timer.restart();
+    loadGenerated(buffer);
+    updateStatus(msg + " | loaded in " + QString::number(timer.nsecsElapsed() / 1e6, 'f', 1) + " ms", "success");
+    update();
+}
+
+// Replaces the current graph with a generated one; models with coordinates keep their geometry
+void GraphVisualizer::loadGenerated(const GraphGenerators::EdgeBuffer& b) {
+    stopTraversalAnimation();
+    UnifiedGraph::Type type = b.directed ? (b.weighted ? UnifiedGraph::DirectedWeighted : UnifiedGraph::DirectedUnweighted)
+                                         : (b.weighted ? UnifiedGraph::UndirectedWeighted : UnifiedGraph::UndirectedUnweighted);
+    // The combo's handler would load the sample graph for the new type
+    typeCombo->blockSignals(true);
+    typeCombo->setCurrentIndex(type);
+    typeCombo->blockSignals(false);
+    edgeW->setVisible(b.weighted);
+
+    graph = UnifiedGraph(type);
+    applyEdgePolicy();
+    for (int i = 0; i < b.n; i++) graph.addVertex();
+    for (long long i = 0; i < b.edgeCount(); i++) graph.addEdge(b.src[i], b.dst[i], b.weighted ? b.weight[i] : 1);
+
+    selectedStart = -1;
+    highlightedVertex = -1;
+    flowSource = flowSink = -1;
+    showFlow = false;
+    maxFlowBtn->setChecked(false);
+
+    if (b.hasCoordinates()) {
+        int controlsBottom = 0;
+        if (controlGroup && controlGroup->isVisible()) controlsBottom = controlGroup->geometry().bottom();
+        if (statusLabel && statusLabel->isVisible() && statusLabel->geometry().bottom() > controlsBottom) controlsBottom = statusLabel->geometry().bottom();
+        int topOffset = std::max(180, controlsBottom + 30);
+        int sideMargin = 60;
+        double left = sideMargin + 25.0, right = std::max(left + 150, (double)(width() - sideMargin - 25));
+        double top = topOffset + 25.0, bottom = std::max(top + 150, (double)(height() - 40 - 25));
+        nodePositions.clear();
+        nodePositions.reserve(b.n);
+        for (int i = 0; i < b.n; i++) nodePositions.emplace_back(left + (right - left) * b.x[i], top + (bottom - top) * b.y[i]);
+        layoutRevision = graph.revision();
+    } else {
+        computeLayout();
+    }
+    invalidateAnalytics();
+}
+
 void GraphVisualizer::onToggleLayoutMode() {
     useForceLayout = !useForceLayout;
     toggleLayoutBtn->setChecked(useForceLayout);
     toggleLayoutBtn->setText(useForceLayout ? "Force: On" : "Force: Off");
     nodePositions.clear();
     computeLayout();
-    updateStatus(useForceLayout ? "Force-directed layout enabled" : "Radial/grid layout enabled", "info");
+    if (useForceLayout && graph.liveVertexCount() > FORCE_LAYOUT_LIMIT)
+        updateStatus("Force layout is limited to " + QString::number(FORCE_LAYOUT_LIMIT) + " vertices - using the k-core onion layout", "info");
+    else
+        updateStatus(useForceLayout ? "Force-directed layout enabled" : "Radial/grid layout enabled", "info");
+    update();
+}
+
+void GraphVisualizer::onToggleOnionLayout() {
+    useOnionLayout = !useOnionLayout;
+    onionBtn->setChecked(useOnionLayout);
+    nodePositions.clear();
+    computeLayout();
+    updateStatus(useOnionLayout ? coreText : "Onion layout off", "info");
     update();
 }
 
@@ -506,6 +961,562 @@ void GraphVisualizer::onFitView() {
     update();
 }
 
+void GraphVisualizer::onToggleCompactAdjacency() {
+    useCompact = !useCompact;
+    compactBtn->setChecked(useCompact);
+    stopTraversalAnimation();
+    if (!useCompact) {
+        compactGraph = CompressedGraph();
+        updateStatus("Compact adjacency off - traversals and edges read the adjacency lists", "info");
+        update();
+        return;
+    }
+    QElapsedTimer timer;
+    timer.start();
+    compactGraph = CompressedGraph::build(graph);
+    qint64 us = timer.nsecsElapsed() / 1000;
+    auto report = CompressedGraph::compare(graph, compactGraph);
+    updateStatus(QString("Compact adjacency on: %1 arcs in %2 B (adjacency lists %3 B, CSR %4 B, %5x smaller), encoded in %6 µs")
+                     .arg(report.arcs)
+                     .arg(report.compressedBytes)
+                     .arg(report.adjacencyListBytes)
+                     .arg(report.csrBytes)
+                     .arg(report.ratio(), 0, 'f', 2)
+                     .arg(us),
+                 "success");
+    update();
+}
+
+void GraphVisualizer::onToggleDistanceMatrix() {
+    showDistanceMatrix = !showDistanceMatrix;
+    matrixBtn->setChecked(showDistanceMatrix);
+    if (!showDistanceMatrix) {
+        distanceImage = QImage();
+        updateStatus("Distance matrix hidden", "info");
+        update();
+        return;
+    }
+    if (graph.vertexCount() == 0) {
+        showDistanceMatrix = false;
+        matrixBtn->setChecked(false);
+        updateStatus("Graph is empty.", "error");
+        return;
+    }
+    if (graph.vertexCount() > DISTANCE_MATRIX_LIMIT) {
+        showDistanceMatrix = false;
+        matrixBtn->setChecked(false);
+        updateStatus("Distance matrix is limited to " + QString::number(DISTANCE_MATRIX_LIMIT) + " vertices (" +
+                     QString::number(graph.vertexCount()) + " here): it needs n² cells and O(n³) time", "error");
+        return;
+    }
+    rebuildDistanceMatrix();
+    updateStatus(apspSummary, apsp.negativeCycle ? "error" : "success");
+    update();
+}
+
+// Called after every structural change; derived results are recomputed only while visible
+void GraphVisualizer::invalidateAnalytics() {
+    stopTraversalAnimation(); // a live cursor must not see the graph change under it
+    metricCache.clear();
+    if (dropOversizedBetweenness()) analyticsNotice = "betweenness turned off: O(V·E) is too slow for this graph";
+    if (communityCombo->currentIndex() > 0) rebuildCommunities();
+    if (coloringCombo->currentIndex() > 0) rebuildColoring();
+    if (showMatching && !rebuildMatching(false)) {
+        showMatching = false;
+        matchingBtn->setChecked(false);
+    }
+    if (useCompact) compactGraph = CompressedGraph::build(graph);
+    if (showDistanceMatrix && graph.vertexCount() > DISTANCE_MATRIX_LIMIT) {
+        showDistanceMatrix = false;
+        matrixBtn->setChecked(false);
+        distanceImage = QImage();
+        if (!analyticsNotice.isEmpty()) analyticsNotice += "; ";
+        analyticsNotice += "distance matrix turned off: " + QString::number(graph.vertexCount()) + " vertices is over its " +
+                          QString::number(DISTANCE_MATRIX_LIMIT) + "-vertex limit";
+    } else if (showDistanceMatrix) {
+        rebuildDistanceMatrix();
+    }
+    if (showFlow) {
+        if (flowSource < graph.vertexCount() && flowSink < graph.vertexCount()) {
+            rebuildMaxFlow();
+        } else {
+            showFlow = false;
+            maxFlowBtn->setChecked(false);
+        }
+    }
+}
+
+void GraphVisualizer::onCommunityModeChanged() {
+    if (communityCombo->currentIndex() == 0) {
+        communities = Communities::Result();
+        communitySummary = Communities::Summary();
+        overviewOrder.clear();
+        showOverview = false;
+        overviewBtn->setChecked(false);
+        updateStatus("Community colouring off", "info");
+        update();
+        return;
+    }
+    rebuildCommunities();
+    updateStatus(communityText, "success");
+    update();
+}
+
+void GraphVisualizer::onToggleOverview() {
+    showOverview = !showOverview;
+    if (showOverview && communityCombo->currentIndex() == 0) {
+        // The overview needs a partition; Louvain gives the coarser, more readable one
+        communityCombo->setCurrentIndex(2);
+    }
+    overviewBtn->setChecked(showOverview);
+    updateStatus(showOverview ? communityText + " | overview: one disc per community" : "Overview hidden", "info");
+    update();
+}
+
+void GraphVisualizer::rebuildCommunities() {
+    QElapsedTimer timer;
+    timer.start();
+    CSRGraph csr = CSRGraph::freeze(graph);
+    bool louvain = communityCombo->currentIndex() == 2;
+    communities = Communities::compute(csr, louvain ? Communities::Method::Louvain : Communities::Method::LabelPropagation);
+    double ms = timer.nsecsElapsed() / 1e6;
+    communitySummary = Communities::summarize(csr.symmetrize(), communities);
+    overviewOrder.resize(communitySummary.count);
+    for (int c = 0; c < communitySummary.count; c++) overviewOrder[c] = c;
+    std::stable_sort(overviewOrder.begin(), overviewOrder.end(),
+                     [&](int a, int b) { return communitySummary.size[a] > communitySummary.size[b]; });
+
+    communityText = QString(louvain ? "Louvain" : "Label propagation") + ": " + QString::number(communities.count) +
+                    " communities, modularity " + QString::number(communities.modularity, 'f', 3) + " | " +
+                    QString::number(ms, 'f', 1) + " ms, " + QString::number(communities.rounds) +
+                    (louvain ? " level(s)" : " round(s)");
+}
+
+void GraphVisualizer::onColoringChanged() {
+    if (coloringCombo->currentIndex() == 0) {
+        coloring = GraphColoring::Result();
+        updateStatus("Vertex colouring off", "info");
+        update();
+        return;
+    }
+    if (graph.isDirected()) {
+        coloringCombo->setCurrentIndex(0);
+        updateStatus("Graph colouring needs an undirected graph type.", "error");
+        return;
+    }
+    rebuildColoring();
+    updateStatus(coloringText, "success");
+    update();
+}
+
+void GraphVisualizer::rebuildColoring() {
+    if (graph.isDirected()) {
+        coloring = GraphColoring::Result();
+        return;
+    }
+    bool parallel = coloringCombo->currentIndex() == 2;
+    CSRGraph sym = CSRGraph::freeze(graph).symmetrize();
+    QElapsedTimer timer;
+    timer.start();
+    coloring = parallel ? GraphColoring::jonesPlassmann(sym) : GraphColoring::smallestLast(sym);
+    double ms = timer.nsecsElapsed() / 1e6;
+    coloringText = QString(parallel ? "Jones–Plassmann" : "Smallest-last") + ": " + QString::number(coloring.colors) +
+                   " colours in " + QString::number(ms, 'f', 2) + " ms";
+    if (parallel) coloringText += " (" + QString::number(coloring.rounds) + " rounds, " + QString::number(Parallel::threadCount()) + " thread(s))";
+    else coloringText += " (degeneracy " + QString::number(coloring.degeneracy) + ")";
+}
+
+// Golden-angle hues keep neighbouring IDs apart; singletons stay grey so they do not add noise
+QColor GraphVisualizer::communityColor(int c) const {
+    if (c < 0 || c >= communitySummary.count || communitySummary.size[c] <= 1) return QColor("#bdc3c7");
+    return QColor::fromHsv((int)std::fmod(c * 137.508, 360.0), 170, 215);
+}
+
+// Largest communities on a sunflower spiral from the centre outwards, disc area ~ member count,
+// links drawn thicker the more edge weight runs between two communities
+void GraphVisualizer::drawCommunityOverview(QPainter& p, const QRect& area) {
+    const int shown = std::min((int)overviewOrder.size(), 300);
+    if (shown == 0) return;
+    std::vector<int> slot(communitySummary.count, -1);
+    for (int i = 0; i < shown; i++) slot[overviewOrder[i]] = i;
+
+    double cx = area.center().x(), cy = area.center().y();
+    double discRadius = std::max(60.0, std::min(area.width(), area.height()) / 2.0 - 40);
+    double maxSize = communitySummary.size[overviewOrder[0]];
+    double maxR = std::min(60.0, discRadius / std::sqrt((double)shown) * 0.9 + 6);
+    const double goldenAngle = M_PI * (3.0 - std::sqrt(5.0));
+    std::vector<QPointF> pos(shown);
+    std::vector<double> radius(shown);
+    long long covered = 0;
+    for (int i = 0; i < shown; i++) {
+        double rr = discRadius * std::sqrt((i + 0.5) / shown);
+        pos[i] = QPointF(cx + rr * cos(i * goldenAngle), cy + rr * sin(i * goldenAngle));
+        radius[i] = std::max(3.0, maxR * std::sqrt(communitySummary.size[overviewOrder[i]] / maxSize));
+        covered += communitySummary.size[overviewOrder[i]];
+    }
+
+    double maxLink = 0;
+    for (size_t k = 0; k < communitySummary.src.size(); k++)
+        if (slot[communitySummary.src[k]] >= 0 && slot[communitySummary.dst[k]] >= 0) maxLink = std::max(maxLink, communitySummary.weight[k]);
+    for (size_t k = 0; k < communitySummary.src.size(); k++) {
+        int a = slot[communitySummary.src[k]], b = slot[communitySummary.dst[k]];
+        if (a < 0 || b < 0) continue;
+        double share = communitySummary.weight[k] / maxLink;
+        p.setPen(QPen(QColor(44, 62, 80, (int)(40 + 140 * share)), 1.0 + 6.0 * share));
+        p.drawLine(pos[a], pos[b]);
+    }
+
+    p.setFont(QFont("Arial", 8, QFont::Bold));
+    for (int i = 0; i < shown; i++) {
+        int c = overviewOrder[i];
+        QColor fill = communityColor(c);
+        p.setBrush(fill);
+        p.setPen(QPen(fill.darker(140), 2));
+        p.drawEllipse(pos[i], radius[i], radius[i]);
+        if (radius[i] >= 14) {
+            p.setPen(Qt::white);
+            p.drawText(QRectF(pos[i].x() - radius[i], pos[i].y() - radius[i], 2 * radius[i], 2 * radius[i]),
+                       Qt::AlignCenter, QString::number(communitySummary.size[c]));
+        }
+    }
+
+    QString legend = QString::number(shown) + " largest of " + QString::number(communitySummary.count) +
+                     " communities, covering " + QString::number(covered) + " vertices";
+    p.setPen(QColor("#2c3e50"));
+    p.setFont(QFont("Arial", 9, QFont::Bold));
+    p.drawText(area.adjusted(10, 6, -10, 0), Qt::AlignTop | Qt::AlignLeft, legend);
+}
+
+void GraphVisualizer::onToggleMatching() {
+    showMatching = !showMatching;
+    matchingBtn->setChecked(showMatching);
+    if (!showMatching) {
+        stopMatchingAnimation();
+        updateStatus("Matching view hidden", "info");
+        update();
+        return;
+    }
+    if (graph.isDirected()) {
+        showMatching = false;
+        matchingBtn->setChecked(false);
+        updateStatus("Matching needs an undirected graph type.", "error");
+        return;
+    }
+    if (!rebuildMatching(true)) {
+        showMatching = false;
+        matchingBtn->setChecked(false);
+        updateStatus(matchingText, "error");
+        update();
+        return;
+    }
+    updateStatus(matchingText, "success");
+    update();
+}
+
+void GraphVisualizer::stopMatchingAnimation() {
+    if (matchingTimer) {
+        matchingTimer->stop();
+        matchingTimer->deleteLater();
+        matchingTimer = nullptr;
+    }
+    matchingStep = -1;
+    shownMate = matching.mate;
+}
+
+// Returns false when the graph is not bipartite; matchingText then names an odd cycle
+bool GraphVisualizer::rebuildMatching(bool animate) {
+    stopMatchingAnimation();
+    if (graph.isDirected()) return false;
+    QElapsedTimer timer;
+    timer.start();
+    // Paths are only worth recording when they will be replayed one by one
+    const int maxAnimatedPaths = 200;
+    matching = BipartiteMatching::compute(graph, animate && graph.liveVertexCount() <= 2 * maxAnimatedPaths);
+    double ms = timer.nsecsElapsed() / 1e6;
+    if (!matching.sides.bipartite) {
+        QString cycle;
+        for (size_t i = 0; i < matching.sides.oddCycle.size() && i < 12; i++)
+            cycle += (i > 0 ? " - " : "") + QString::number(matching.sides.oddCycle[i]);
+        if (matching.sides.oddCycle.size() > 12) cycle += " - …";
+        matchingText = "Not bipartite: odd cycle " + cycle;
+        matching = BipartiteMatching::Result();
+        shownMate.clear();
+        return false;
+    }
+    int unmatched[2] = {0, 0};
+    for (int u = 0; u < graph.vertexCount(); u++)
+        if (graph.isAlive(u) && matching.mate[u] < 0) ++unmatched[matching.sides.side[u]];
+    matchingText = "Maximum matching: " + QString::number(matching.size) + " pair(s) | Hopcroft–Karp " +
+                   QString::number(matching.phases) + " phase(s), " + QString::number(ms, 'f', 2) + " ms | unmatched: " +
+                   QString::number(unmatched[0]) + " left, " + QString::number(unmatched[1]) + " right";
+
+    shownMate = matching.mate;
+    if (!animate || matching.paths.empty() || (int)matching.paths.size() > maxAnimatedPaths) return true;
+
+    // Replay: each tick applies one augmenting path, which stays highlighted until the next one
+    shownMate.assign(graph.vertexCount(), -1);
+    matchingStep = -1;
+    matchingTimer = new QTimer(this);
+    matchingTimer->setInterval(700);
+    connect(matchingTimer, &QTimer::timeout, this, [this]() {
+        if (matchingStep + 1 >= (int)matching.paths.size()) {
+            stopMatchingAnimation();
+            updateStatus(matchingText, "success");
+            update();
+            return;
+        }
+        const std::vector<int>& path = matching.paths[++matchingStep];
+        for (size_t i = 0; i + 1 < path.size(); i += 2) {
+            shownMate[path[i]] = path[i + 1];
+            shownMate[path[i + 1]] = path[i];
+        }
+        updateStatus("Augmenting path " + QString::number(matchingStep + 1) + "/" + QString::number(matching.paths.size()) +
+                     " (length " + QString::number(path.size() - 1) + ")", "info");
+        update();
+    });
+    matchingTimer->start();
+    return true;
+}
+
+void GraphVisualizer::onToggleMaxFlow() {
+    showFlow = !showFlow;
+    maxFlowBtn->setChecked(showFlow);
+    if (!showFlow) {
+        updateStatus("Flow view hidden", "info");
+        update();
+        return;
+    }
+    int s, t;
+    if (!readFlowEndpoints(s, t)) {
+        showFlow = false;
+        maxFlowBtn->setChecked(false);
+        updateStatus("Enter two different vertex IDs for source and sink.", "error");
+        return;
+    }
+    flowSource = s;
+    flowSink = t;
+    rebuildMaxFlow();
+    updateStatus(flowSummary, "success");
+    update();
+}
+
+void GraphVisualizer::onFlowMethodChanged() {
+    if (!showFlow) return;
+    rebuildMaxFlow();
+    updateStatus(flowSummary, "success");
+    update();
+}
+
+// Source and sink from the inputs (blank: first and last vertex); false unless two different IDs
+bool GraphVisualizer::readFlowEndpoints(int& s, int& t) const {
+    int n = graph.vertexCount();
+    bool okS = true, okT = true;
+    s = flowSourceInput->text().isEmpty() ? 0 : flowSourceInput->text().toInt(&okS);
+    t = flowSinkInput->text().isEmpty() ? n - 1 : flowSinkInput->text().toInt(&okT);
+    return okS && okT && s >= 0 && t >= 0 && s < n && t < n && s != t;
+}
+
+// Only the selected engine runs; comparing both is the Compare button's job
+void GraphVisualizer::rebuildMaxFlow() {
+    auto method = (MaxFlow::Method)flowMethodCombo->currentIndex();
+    QElapsedTimer timer;
+    timer.start();
+    flowResult = MaxFlow::compute(graph, flowSource, flowSink, method);
+    double ms = timer.nsecsElapsed() / 1e6;
+
+    bool pushRelabel = method == MaxFlow::Method::PushRelabel;
+    flowSummary = "Max flow " + QString::number(flowSource) + " → " + QString::number(flowSink) + " = " +
+                  QString::number(flowResult.value) + " | cut: " + QString::number(flowResult.cutEdges.size()) +
+                  " edge(s) | " + flowMethodCombo->currentText() + " " + QString::number(ms, 'f', 2) + " ms (" +
+                  QString::number(flowResult.operations) + (pushRelabel ? " pushes)" : " paths)");
+}
+
+// One-off timing of both engines on the current source and sink; the flow view is left as it is
+void GraphVisualizer::onCompareMaxFlow() {
+    int s, t;
+    if (!readFlowEndpoints(s, t)) {
+        updateStatus("Enter two different vertex IDs for source and sink.", "error");
+        return;
+    }
+    QElapsedTimer timer;
+    timer.start();
+    MaxFlow::Result pushRelabel = MaxFlow::compute(graph, s, t, MaxFlow::Method::PushRelabel);
+    double prMs = timer.nsecsElapsed() / 1e6;
+    timer.restart();
+    MaxFlow::Result dinic = MaxFlow::compute(graph, s, t, MaxFlow::Method::Dinic);
+    double dinicMs = timer.nsecsElapsed() / 1e6;
+    QString msg = "Max flow " + QString::number(s) + " → " + QString::number(t) + " = " + QString::number(pushRelabel.value) +
+                  " | push-relabel " + QString::number(prMs, 'f', 2) + " ms (" + QString::number(pushRelabel.operations) +
+                  " pushes), Dinic " + QString::number(dinicMs, 'f', 2) + " ms (" + QString::number(dinic.operations) + " paths)";
+    if (pushRelabel.value != dinic.value) {
+        updateStatus(msg + " | ❌ Dinic found " + QString::number(dinic.value), "error");
+        return;
+    }
+    updateStatus(msg, "info");
+}
+
+bool GraphVisualizer::betweennessTooLarge() const {
+    return (double)graph.liveVertexCount() * graph.arcCount() > BETWEENNESS_WORK_LIMIT;
+}
+
+// Resets any metric combo still asking for betweenness on a graph too large for it; true if one was reset
+bool GraphVisualizer::dropOversizedBetweenness() {
+    if (!betweennessTooLarge()) return false;
+    bool dropped = false;
+    for (QComboBox* combo : {sizeMetricCombo, colorMetricCombo}) {
+        if (combo->currentIndex() != MetricBetweenness) continue;
+        combo->blockSignals(true);
+        combo->setCurrentIndex(MetricNone);
+        combo->blockSignals(false);
+        dropped = true;
+    }
+    return dropped;
+}
+
+void GraphVisualizer::onMetricMappingChanged() {
+    if (dropOversizedBetweenness()) {
+        updateStatus("Betweenness is O(V·E): limited to V·E ≤ " + QString::number(BETWEENNESS_WORK_LIMIT, 'g', 3) +
+                     ", this graph has " + QString::number(graph.liveVertexCount()) + " vertices and " +
+                     QString::number(graph.arcCount()) + " arcs", "error");
+        update();
+        return;
+    }
+    if (graph.vertexCount() == 0 || (sizeMetricCombo->currentIndex() == MetricNone && colorMetricCombo->currentIndex() == MetricNone)) {
+        updateStatus("Node size and colour are uniform", "info");
+        update();
+        return;
+    }
+    QElapsedTimer timer;
+    timer.start();
+    metricScores(sizeMetricCombo->currentIndex());
+    metricScores(colorMetricCombo->currentIndex());
+    double ms = timer.nsecsElapsed() / 1e6;
+    QString msg = "Scores computed in " + QString::number(ms, 'f', 2) + " ms";
+
+    // Report the top live vertex of the metric that was just chosen, from whichever combo changed
+    int metric = (sender() == colorMetricCombo ? colorMetricCombo : sizeMetricCombo)->currentIndex();
+    const std::vector<double>& scores = metricScores(metric);
+    int best = -1;
+    for (int u = 0; u < (int)scores.size(); ++u)
+        if (graph.isAlive(u) && (best < 0 || scores[u] > scores[best])) best = u;
+    if (best >= 0) msg += " - most central vertex: " + QString::number(best);
+    updateStatus(msg, "success");
+    update();
+}
+
+void GraphVisualizer::onCountTriangles() {
+    if (graph.vertexCount() == 0) {
+        updateStatus("Graph is empty.", "error");
+        return;
+    }
+    if (graph.isDirected()) {
+        updateStatus("Triangle counting needs an undirected graph type.", "error");
+        return;
+    }
+    // Switch the colouring first: the combo's own handler also writes the status line
+    colorMetricCombo->setCurrentIndex(MetricClustering);
+    QElapsedTimer timer;
+    timer.start();
+    auto result = TriangleCounting::count(CSRGraph::freezeCanonical(graph));
+    double ms = timer.nsecsElapsed() / 1e6;
+    updateStatus("Triangles: " + QString::number(result.triangles) + " | avg clustering " +
+                 QString::number(result.averageClustering, 'f', 3) + " (" + QString::number(ms, 'f', 2) + " ms)", "success");
+    update();
+}
+
+const std::vector<double>& GraphVisualizer::metricScores(int metric) {
+    auto it = metricCache.find(metric);
+    if (it != metricCache.end()) return it->second;
+
+    std::vector<double> raw;
+    if (metric != MetricNone && graph.vertexCount() > 0) {
+        CSRGraph csr = CSRGraph::freeze(graph);
+        if (metric == MetricDegree) raw = Centrality::degree(csr);
+        else if (metric == MetricPageRank) raw = Centrality::pageRank(csr);
+        else if (metric == MetricBetweenness && !betweennessTooLarge()) raw = Centrality::betweenness(csr);
+        else if (metric == MetricClustering && !graph.isDirected())
+            raw = TriangleCounting::count(CSRGraph::freezeCanonical(graph)).clustering;
+        else if (metric == MetricCore) {
+            KCore::Result cores = KCore::compute(csr);
+            raw.assign(cores.core.begin(), cores.core.end());
+        }
+    }
+    // Min-max normalize so the painter can map straight onto radius and hue
+    if (!raw.empty()) {
+        auto [lo, hi] = std::minmax_element(raw.begin(), raw.end());
+        double base = *lo, span = *hi - *lo;
+        for (double& v : raw) v = span > 0 ? (v - base) / span : 0.5;
+    }
+    return metricCache.emplace(metric, std::move(raw)).first->second;
+}
+
+void GraphVisualizer::rebuildDistanceMatrix() {
+    QElapsedTimer timer;
+    timer.start();
+    apsp = AllPairsShortestPaths::compute(graph);
+    double ms = timer.nsecsElapsed() / 1e6;
+
+    QString method = apsp.used == AllPairsShortestPaths::Method::Johnson ? "Johnson" : "blocked Floyd-Warshall";
+    apspSummary = "All-pairs distances via " + method + " in " + QString::number(ms, 'f', 2) + " ms";
+    int n = apsp.n;
+    if (apsp.negativeCycle || n == 0) {
+        if (apsp.negativeCycle) apspSummary = "❌ Negative cycle detected - distances are undefined";
+        distanceImage = QImage();
+        return;
+    }
+
+    int lo = AllPairsShortestPaths::INF, hi = 0;
+    for (int d : apsp.dist) {
+        if (d >= AllPairsShortestPaths::INF / 2) continue;
+        lo = std::min(lo, d);
+        hi = std::max(hi, d);
+    }
+    double span = std::max(1, hi - lo);
+
+    // Write pixels straight into the image; painting then costs one scaled blit
+    distanceImage = QImage(n, n, QImage::Format_RGB32);
+    const QRgb unreachable = qRgb(52, 73, 94);
+    for (int i = 0; i < n; ++i) {
+        QRgb* line = reinterpret_cast<QRgb*>(distanceImage.scanLine(i));
+        const int* row = apsp.dist.data() + (size_t)i * n;
+        for (int j = 0; j < n; ++j) {
+            if (row[j] >= AllPairsShortestPaths::INF / 2) { line[j] = unreachable; continue; }
+            // green (near) -> yellow -> red (far)
+            double t = (row[j] - lo) / span;
+            int red = (int)(46 + std::min(1.0, t * 2.0) * (231 - 46));
+            int green = (int)(204 - std::max(0.0, t * 2.0 - 1.0) * (204 - 76));
+            line[j] = qRgb(red, green, 60);
+        }
+    }
+    apspSummary += " | range " + QString::number(lo) + "-" + QString::number(hi);
+}
+
+void GraphVisualizer::drawDistanceMatrix(QPainter& p, const QRect& viewport) {
+    if (!showDistanceMatrix || distanceImage.isNull()) return;
+    int n = distanceImage.width();
+    int side = std::min(260, std::min(viewport.width(), viewport.height()) - 40);
+    if (side < 60) return;
+    // Snap to whole pixels per cell so cells keep equal size
+    if (n <= side) side = (side / n) * n;
+    QRect panel(viewport.right() - side - 24, viewport.top() + 28, side, side);
+
+    p.save();
+    p.setClipRect(viewport);
+    p.setPen(Qt::NoPen);
+    p.setBrush(QColor(255, 255, 255, 235));
+    p.drawRoundedRect(panel.adjusted(-10, -24, 10, 10), 8, 8);
+    p.setPen(QColor("#2c3e50"));
+    p.setFont(QFont("Arial", 9, QFont::Bold));
+    p.drawText(QRect(panel.left(), panel.top() - 22, side, 20), Qt::AlignLeft | Qt::AlignVCenter,
+               "Distance matrix (" + QString::number(n) + "x" + QString::number(n) + ")");
+    p.setRenderHint(QPainter::SmoothPixmapTransform, false);
+    p.drawImage(panel, distanceImage);
+    p.setPen(QPen(QColor("#7f8c8d"), 1));
+    p.setBrush(Qt::NoBrush);
+    p.drawRect(panel);
+    p.restore();
+}
+
 void GraphVisualizer::computeCircularLayout() {
     nodePositions.clear();
     int n = graph.vertexCount();
@@ -570,6 +1581,18 @@ void GraphVisualizer::computeCircularLayout() {
     double centerX = drawWidth / 2.0 + sideMargin;
     double centerY = topOffset + drawHeight / 2.0;
 
+    // Generated graphs: rings would run off screen, so fill a disc with a sunflower spiral instead
+    if (n > DENSE_VIEW_LIMIT) {
+        double discRadius = std::max(60.0, std::min(drawWidth, drawHeight) / 2.0 - 20);
+        const double goldenAngle = M_PI * (3.0 - std::sqrt(5.0));
+        nodePositions.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            double radius = discRadius * std::sqrt((i + 0.5) / n);
+            nodePositions.emplace_back(centerX + radius * cos(i * goldenAngle), centerY + radius * sin(i * goldenAngle));
+        }
+        return;
+    }
+
     int maxPerRing = 22; // spread nodes across rings
     int ringCount = (n + maxPerRing - 1) / maxPerRing;
     double baseRadius = std::min(drawWidth, drawHeight) / 2.0 - 90;
@@ -591,6 +1614,110 @@ void GraphVisualizer::computeCircularLayout() {
     }
 }
 
+// Side 0 in the left column in ID order, side 1 on the right sorted by the mean row of its left
+// neighbours (barycentre heuristic), which keeps most edges, and matched pairs, nearly horizontal
+void GraphVisualizer::computeBipartiteLayout(const std::vector<int>& side) {
+    int n = graph.vertexCount();
+    nodePositions.assign(n, NodePos());
+    int controlsBottom = 0;
+    if (controlGroup && controlGroup->isVisible()) controlsBottom = controlGroup->geometry().bottom();
+    if (statusLabel && statusLabel->isVisible() && statusLabel->geometry().bottom() > controlsBottom) controlsBottom = statusLabel->geometry().bottom();
+    int topOffset = std::max(180, controlsBottom + 30);
+    int sideMargin = 60;
+    int drawHeight = std::max(150, height() - topOffset - 40);
+    int drawWidth = std::max(150, width() - 2 * sideMargin);
+
+    std::vector<int> left, right;
+    std::vector<int> row(n, -1);
+    for (int u = 0; u < n; u++) {
+        if (!graph.isAlive(u)) continue;
+        if (side[u] == 0) { row[u] = (int)left.size(); left.push_back(u); }
+        else right.push_back(u);
+    }
+    std::vector<double> barycentre(n, 1e18);
+    for (int v : right) {
+        double sum = 0;
+        int count = 0;
+        for (const auto& e : graph.neighbors(v))
+            if (row[e.to] >= 0) { sum += row[e.to]; ++count; }
+        if (count > 0) barycentre[v] = sum / count;
+    }
+    std::stable_sort(right.begin(), right.end(), [&](int a, int b) { return barycentre[a] < barycentre[b]; });
+
+    auto place = [&](const std::vector<int>& column, double x) {
+        double step = drawHeight / (double)std::max<size_t>(1, column.size());
+        for (size_t i = 0; i < column.size(); i++) nodePositions[column[i]] = NodePos(x, topOffset + step * (i + 0.5));
+    };
+    place(left, sideMargin + drawWidth * 0.25);
+    place(right, sideMargin + drawWidth * 0.75);
+}
+
+// k-core "onion": shells of equal core number around the centre, highest core innermost. Small
+// graphs get one ring per shell; large ones a sunflower spiral ranked by core, with a gap between
+// shells, so the layout costs O(V + E) however big the graph is.
+void GraphVisualizer::computeOnionLayout() {
+    int n = graph.vertexCount();
+    nodePositions.assign(n, NodePos());
+    onionShells.clear();
+    if (n == 0) return;
+
+    QElapsedTimer timer;
+    timer.start();
+    CSRGraph sym = CSRGraph::freeze(graph).symmetrize();
+    KCore::Result cores = KCore::batageljZaversnik(sym);
+    double coreMs = timer.nsecsElapsed() / 1e6;
+
+    int controlsBottom = 0;
+    if (controlGroup && controlGroup->isVisible()) controlsBottom = controlGroup->geometry().bottom();
+    if (statusLabel && statusLabel->isVisible() && statusLabel->geometry().bottom() > controlsBottom) controlsBottom = statusLabel->geometry().bottom();
+    int topOffset = std::max(180, controlsBottom + 30);
+    int sideMargin = 60;
+    int drawHeight = std::max(150, height() - topOffset - 40);
+    int drawWidth = std::max(150, width() - 2 * sideMargin);
+    onionCentre = NodePos(sideMargin + drawWidth / 2.0, topOffset + drawHeight / 2.0);
+    double maxRadius = std::max(60.0, std::min(drawWidth, drawHeight) / 2.0 - 30);
+
+    // Live vertices by core number, highest first; BZ order within a shell keeps peeling neighbours close
+    std::vector<int> ranked;
+    for (int i = n - 1; i >= 0; i--)
+        if (graph.isAlive(cores.order[i])) ranked.push_back(cores.order[i]);
+    std::stable_sort(ranked.begin(), ranked.end(), [&](int a, int b) { return cores.core[a] > cores.core[b]; });
+    std::vector<std::pair<int, int>> shells; // [begin, end) in ranked
+    for (int i = 0; i < (int)ranked.size(); i++)
+        if (i == 0 || cores.core[ranked[i]] != cores.core[ranked[i - 1]]) shells.emplace_back(i, i + 1);
+        else shells.back().second = i + 1;
+    int shellCount = (int)shells.size();
+
+    if (graph.liveVertexCount() <= DENSE_VIEW_LIMIT) {
+        for (int s = 0; s < shellCount; s++) {
+            auto [begin, end] = shells[s];
+            double radius = shellCount == 1 ? maxRadius * 0.6 : maxRadius * (0.15 + 0.85 * s / (shellCount - 1));
+            if (s == 0 && end - begin == 1) radius = 0; // a lone top-core vertex sits in the middle
+            for (int i = begin; i < end; i++) {
+                double angle = 2.0 * M_PI * (i - begin) / (end - begin) + s * 0.5;
+                nodePositions[ranked[i]] = NodePos(onionCentre.x + radius * cos(angle), onionCentre.y + radius * sin(angle));
+            }
+            onionShells.emplace_back(cores.core[ranked[begin]], radius);
+        }
+    } else {
+        const double goldenAngle = M_PI * (3.0 - std::sqrt(5.0));
+        double gap = std::max(1.0, ranked.size() / (10.0 * shellCount)); // spiral slots left empty between shells
+        double totalSlots = ranked.size() + gap * (shellCount - 1);
+        for (int s = 0; s < shellCount; s++) {
+            auto [begin, end] = shells[s];
+            for (int i = begin; i < end; i++) {
+                double slot = i + gap * s;
+                double radius = maxRadius * std::sqrt((slot + 0.5) / totalSlots);
+                nodePositions[ranked[i]] = NodePos(onionCentre.x + radius * cos(slot * goldenAngle), onionCentre.y + radius * sin(slot * goldenAngle));
+            }
+            onionShells.emplace_back(cores.core[ranked[begin]], maxRadius * std::sqrt((end + gap * s) / totalSlots));
+        }
+    }
+
+    coreText = "k-core onion: " + QString::number(shellCount) + " shell(s), degeneracy " + QString::number(cores.maxCore) +
+               " | Batagelj–Zaversnik " + QString::number(coreMs, 'f', 2) + " ms";
+}
+
 void GraphVisualizer::computeForceLayout() {
     nodePositions.clear();
     int n = graph.vertexCount();
@@ -621,20 +1748,39 @@ void GraphVisualizer::computeForceLayout() {
         nodePositions.emplace_back(cx + radius * cos(angle) + rx, cy + radius * sin(angle) + ry);
     }
 
-    // Fruchterman-Reingold style relaxation
+    relaxForceLayout(std::clamp(80 + n * 2, 80, 220), 0.06);
+}
+
+// Fruchterman-Reingold relaxation from the current positions. A full layout starts hot; after an
+// incremental change a short, cool pass lets new nodes and edges settle while the rest barely move.
+void GraphVisualizer::relaxForceLayout(int iterations, double heat) {
+    int n = std::min(graph.vertexCount(), (int)nodePositions.size());
+    if (n == 0) return;
+
+    int controlsBottom = 0;
+    if (controlGroup && controlGroup->isVisible()) controlsBottom = controlGroup->geometry().bottom();
+    if (statusLabel && statusLabel->isVisible() && statusLabel->geometry().bottom() > controlsBottom) controlsBottom = statusLabel->geometry().bottom();
+
+    int topOffset = std::max(200, controlsBottom + 50);
+    int bottomMargin = 40;
+    int sideMargin = 60;
+    int drawHeight = std::max(200, height() - topOffset - bottomMargin);
+    int drawWidth = std::max(200, width() - 2 * sideMargin);
+
     double area = (double)drawWidth * (double)drawHeight;
-    double k = std::sqrt(area / std::max(1, n));
-    int iterations = std::clamp(80 + n * 2, 80, 220);
-    double cooling = std::max(drawWidth, drawHeight) * 0.06;
+    double k = std::sqrt(area / std::max(1, graph.liveVertexCount()));
+    double cooling = std::max(drawWidth, drawHeight) * heat;
 
     std::vector<NodePos> disp(n, NodePos(0, 0));
 
     for (int it = 0; it < iterations; ++it) {
         std::fill(disp.begin(), disp.end(), NodePos(0, 0));
 
-        // Repulsive forces
+        // Repulsive forces (removed vertices keep their slot but take no part)
         for (int i = 0; i < n; ++i) {
+            if (!graph.isAlive(i)) continue;
             for (int j = i + 1; j < n; ++j) {
+                if (!graph.isAlive(j)) continue;
                 double dx = nodePositions[i].x - nodePositions[j].x;
                 double dy = nodePositions[i].y - nodePositions[j].y;
                 double dist = std::sqrt(dx * dx + dy * dy) + 0.01;
@@ -647,7 +1793,7 @@ void GraphVisualizer::computeForceLayout() {
         }
 
         // Attractive forces along edges
-        for (int u = 0; u < graph.vertexCount(); ++u) {
+        for (int u = 0; u < n; ++u) {
             for (const auto& e : graph.neighbors(u)) {
                 int v = e.to;
                 if (v == u || v >= n) continue;
@@ -679,9 +1825,101 @@ void GraphVisualizer::computeForceLayout() {
     }
 }
 
+// Puts a new vertex in the emptiest spot: the candidate point farthest from every live node
+NodePos GraphVisualizer::freeSpotFor(int u) const {
+    int controlsBottom = 0;
+    if (controlGroup && controlGroup->isVisible()) controlsBottom = controlGroup->geometry().bottom();
+    if (statusLabel && statusLabel->isVisible() && statusLabel->geometry().bottom() > controlsBottom) controlsBottom = statusLabel->geometry().bottom();
+
+    int topOffset = std::max(180, controlsBottom + 30);
+    int sideMargin = 60;
+    double left = sideMargin + 25.0, right = std::max(left + 150, (double)(width() - sideMargin - 25));
+    double top = topOffset + 25.0, bottom = std::max(top + 150, (double)(height() - 40 - 25));
+
+    NodePos best((left + right) / 2, (top + bottom) / 2);
+    double bestGap = -1;
+    const int steps = 12;
+    for (int gx = 0; gx <= steps; ++gx) {
+        for (int gy = 0; gy <= steps; ++gy) {
+            NodePos c(left + (right - left) * gx / steps, top + (bottom - top) * gy / steps);
+            double gap = 1e18;
+            for (int v = 0; v < (int)nodePositions.size(); ++v) {
+                if (v == u || !graph.isAlive(v)) continue;
+                double dx = c.x - nodePositions[v].x, dy = c.y - nodePositions[v].y;
+                gap = std::min(gap, dx * dx + dy * dy);
+            }
+            if (gap > bestGap) { bestGap = gap; best = c; }
+        }
+    }
+    return best;
+}
+
+// Replays the graph's change log onto the layout so existing nodes keep their place. Falls back to
+// a full layout when the log no longer reaches back to the revision the layout was built from.
+void GraphVisualizer::applyGraphChanges() {
+    std::vector<UnifiedGraph::Change> changes;
+    if (nodePositions.empty() || !graph.changesSince(layoutRevision, changes)) {
+        computeLayout();
+        return;
+    }
+    bool settle = false;
+    for (const auto& c : changes) {
+        switch (c.kind) {
+            case UnifiedGraph::Change::Reset:
+                computeLayout();
+                return;
+            case UnifiedGraph::Change::VertexAdded:
+                if ((int)nodePositions.size() <= c.u) nodePositions.resize(c.u + 1);
+                nodePositions[c.u] = freeSpotFor(c.u);
+                settle = true;
+                break;
+            case UnifiedGraph::Change::VertexMoved:
+                nodePositions[c.v] = nodePositions[c.u];
+                break;
+            case UnifiedGraph::Change::Compacted:
+                nodePositions.resize(c.u);
+                break;
+            case UnifiedGraph::Change::WeightChanged:
+                break;
+            case UnifiedGraph::Change::VertexRemoved:
+            case UnifiedGraph::Change::EdgeAdded:
+            case UnifiedGraph::Change::EdgeRemoved:
+                settle = true;
+                break;
+        }
+    }
+    layoutRevision = graph.revision();
+    if ((int)nodePositions.size() != graph.vertexCount()) {
+        computeLayout();
+        return;
+    }
+    // A new edge can flip a component's sides or shift core numbers, so those layouts are redone in full
+    if (settle && (bipartiteLayout || coreLayout)) computeLayout();
+    else if (settle && useForceLayout && graph.liveVertexCount() <= FORCE_LAYOUT_LIMIT) relaxForceLayout(40, 0.01);
+}
+
 void GraphVisualizer::computeLayout() {
-    if (useForceLayout) computeForceLayout();
-    else computeCircularLayout();
+    bipartiteLayout = false;
+    coreLayout = false;
+    bool forceTooLarge = useForceLayout && graph.liveVertexCount() > FORCE_LAYOUT_LIMIT;
+    if (useOnionLayout || forceTooLarge) {
+        computeOnionLayout();
+        coreLayout = true;
+    } else if (useForceLayout) {
+        computeForceLayout();
+    } else if (!graph.isDirected() && graph.arcCount() > 0 && graph.liveVertexCount() <= DENSE_VIEW_LIMIT) {
+        // Task/worker graphs read best as two columns; anything with an odd cycle keeps the usual layout
+        BipartiteMatching::Sides sides = BipartiteMatching::twoColor(CSRGraph::freeze(graph).symmetrize());
+        if (sides.bipartite) {
+            computeBipartiteLayout(sides.side);
+            bipartiteLayout = true;
+        } else {
+            computeCircularLayout();
+        }
+    } else {
+        computeCircularLayout();
+    }
+    layoutRevision = graph.revision();
 }
 
 void GraphVisualizer::paintEvent(QPaintEvent* e) {
@@ -763,6 +2001,37 @@ void GraphVisualizer::drawGraph() {
         computeLayout();
     }
 
+    // Onion guide rings, labelled with their core number
+    if (coreLayout && !onionShells.empty()) {
+        p.setBrush(Qt::NoBrush);
+        p.setFont(QFont("Arial", 8, QFont::Bold));
+        bool labelAll = onionShells.size() <= 12;
+        for (size_t s = 0; s < onionShells.size(); s++) {
+            double radius = onionShells[s].second;
+            if (radius <= 0) continue;
+            p.setPen(QPen(QColor(211, 84, 0, 60), 1, Qt::DashLine));
+            p.drawEllipse(QPointF(onionCentre.x, onionCentre.y), radius, radius);
+            if (labelAll || s == 0 || s + 1 == onionShells.size()) {
+                p.setPen(QColor(211, 84, 0, 160));
+                p.drawText(QPointF(onionCentre.x + radius + 4, onionCentre.y), "k=" + QString::number(onionShells[s].first));
+            }
+        }
+    }
+
+    if (showOverview && communitySummary.count > 0) {
+        drawCommunityOverview(p, QRect(0, topOffset + scrollOffsetY, width(), drawHeight));
+        p.restore();
+        drawDistanceMatrix(p, QRect(0, topOffset, width(), drawHeight));
+        return;
+    }
+    bool byCommunity = (int)communities.community.size() == graph.vertexCount();
+    bool byColorClass = (int)coloring.color.size() == graph.vertexCount();
+    // Colour classes: a fixed palette for the usual handful, golden-angle hues beyond it
+    auto classColor = [](int c) {
+        static const char* palette[] = {"#1abc9c", "#f1c40f", "#9b59b6", "#e67e22", "#2ecc71", "#3498db", "#e84393", "#34495e"};
+        return c < 8 ? QColor(palette[c]) : QColor::fromHsv((int)std::fmod(c * 137.508, 360.0), 160, 200);
+    };
+
     // Draw edges with better visibility
     bool isWeighted = (graph.getType() == UnifiedGraph::DirectedWeighted || graph.getType() == UnifiedGraph::UndirectedWeighted);
     bool isDirected = (graph.getType() == UnifiedGraph::DirectedUnweighted || graph.getType() == UnifiedGraph::DirectedWeighted);
@@ -771,69 +2040,167 @@ void GraphVisualizer::drawGraph() {
     p.setPen(QPen(QColor("#2c3e50"), 3, Qt::SolidLine));
     p.setRenderHint(QPainter::Antialiasing);
     
-    for (int u = 0; u < graph.vertexCount(); u++) {
-        for (const auto& e : graph.neighbors(u)) {
-            int v = e.to;
-            if (!isDirected && u > v) continue; // Avoid drawing undirected edges twice
-            if ((int)nodePositions.size() <= std::max(u, v)) continue;
-
-            double x1 = nodePositions[u].x;
-            double y1 = nodePositions[u].y;
-            double x2 = nodePositions[v].x;
-            double y2 = nodePositions[v].y;
-
-            // Draw shadow for edge
+    bool flowView = showFlow && (int)flowResult.edgeFlow.size() == graph.vertexCount();
+    std::vector<char> isCutArc;
+    if (flowView) {
+        isCutArc.assign(graph.arcCount(), 0);
+        std::vector<long long> base(graph.vertexCount() + 1, 0);
+        for (int u = 0; u < graph.vertexCount(); u++) base[u + 1] = base[u] + (long long)graph.neighbors(u).size();
+        for (const auto& [cu, ci] : flowResult.cutEdges) isCutArc[base[cu] + ci] = 1;
+    }
+    bool matchView = !flowView && showMatching && (int)shownMate.size() == graph.vertexCount();
+    EdgeIndex pathEdges; // edges of the augmenting path being replayed
+    if (matchView && matchingStep >= 0) {
+        const std::vector<int>& path = matching.paths[matchingStep];
+        for (size_t i = 0; i + 1 < path.size(); i++) pathEdges.add(std::min(path[i], path[i + 1]), std::max(path[i], path[i + 1]));
+    }
+    // Parallel edges share one stroke with a ×k badge. With a merging duplicate policy there are
+    // none to skip; the flow view keeps every arc since each carries its own flow.
+    // Large (generated) graphs are drawn as hairlines and dots without labels, shadows or badges
+    bool dense = !flowView && graph.liveVertexCount() > DENSE_VIEW_LIMIT;
+    bool dedupeEdges = !flowView && !dense && !(graph.hasEdgeIndex() && graph.multiEdgePolicy() != UnifiedGraph::MultiEdgePolicy::Keep);
+    EdgeIndex drawnEdges;
+    if (dense) {
+        p.setRenderHint(QPainter::Antialiasing, false);
+        p.setPen(QPen(QColor(44, 62, 80, graph.arcCount() > 20000 ? 25 : 60), 1));
+    }
+
+    // ei/arcIndex locate the arc in the adjacency lists; only the flow overlay needs them
+    auto drawArc = [&](int u, int v, int weight, int ei, long long arcIndex) {
+        if (!isDirected && u > v) return; // Avoid drawing undirected edges twice
+        if ((int)nodePositions.size() <= std::max(u, v)) return;
+        if (dense) {
+            p.drawLine(QPointF(nodePositions[u].x, nodePositions[u].y), QPointF(nodePositions[v].x, nodePositions[v].y));
+            return;
+        }
+        int multiplicity = 1;
+        if (dedupeEdges) {
+            if (drawnEdges.add(u, v) > 1) return;
+            multiplicity = graph.edgeMultiplicity(u, v);
+        }
+
+        double x1 = nodePositions[u].x;
+        double y1 = nodePositions[u].y;
+        double x2 = nodePositions[v].x;
+        double y2 = nodePositions[v].y;
+        bool selfLoop = (u == v);
+        double midX = selfLoop ? x1 : (x1 + x2) / 2;
+        double midY = selfLoop ? y1 - 34 : (y1 + y2) / 2;
+
+        // Flow view: idle arcs fade, saturated arcs turn red, cut arcs get an orange dashed halo
+        QColor edgeColor("#2c3e50");
+        int edgeWidth = 3;
+        long long flow = 0, capacity = 0;
+        if (flowView) {
+            flow = flowResult.edgeFlow[u][ei];
+            capacity = std::max(0, isWeighted ? weight : 1);
+            if (flow == 0) edgeColor = QColor("#bdc3c7");
+            else if (flow == capacity) { edgeColor = QColor("#e74c3c"); edgeWidth = 4; }
+            else edgeColor = QColor("#2980b9");
+            if (isCutArc[arcIndex]) {
+                p.setPen(QPen(QColor("#f39c12"), 9, Qt::DashLine));
+                p.drawLine((int)x1, (int)y1, (int)x2, (int)y2);
+            }
+        }
+
+        // Matching view: matched edges green, the current augmenting path orange, the rest faded
+        if (matchView) {
+            if (pathEdges.contains(std::min(u, v), std::max(u, v))) { edgeColor = QColor("#e67e22"); edgeWidth = 6; }
+            else if (shownMate[u] == v) { edgeColor = QColor("#27ae60"); edgeWidth = 5; }
+            else { edgeColor = QColor("#bdc3c7"); edgeWidth = 2; }
+        }
+
+        if (selfLoop) {
+            // Loop drawn as a ring sitting on top of the node
+            p.setBrush(Qt::NoBrush);
+            p.setPen(QPen(edgeColor, edgeWidth, Qt::SolidLine));
+            p.drawEllipse(QPointF(x1, y1 - 20), 11, 11);
+        }
+
+        // Draw shadow for edge
+        else {
             p.setPen(QPen(QColor(0, 0, 0, 40), 4, Qt::SolidLine));
             p.drawLine((int)x1 + 1, (int)y1 + 1, (int)x2 + 1, (int)y2 + 1);
-            
+        
             // Draw main edge line
-            p.setPen(QPen(QColor("#2c3e50"), 3, Qt::SolidLine));
+            p.setPen(QPen(edgeColor, edgeWidth, Qt::SolidLine));
             p.drawLine((int)x1, (int)y1, (int)x2, (int)y2);
+        }
 
-            // Draw arrow for directed edges
-            if (isDirected && u != v) {
-                double dx = x2 - x1;
-                double dy = y2 - y1;
-                double len = sqrt(dx * dx + dy * dy);
-                if (len > 0) {
-                    dx /= len;
-                    dy /= len;
-                    // Shorten arrow to stop at node edge
-                    double arrowX = x2 - 20 * dx;
-                    double arrowY = y2 - 20 * dy;
-                    double angle = atan2(dy, dx);
-                    int arrowSize = 10;
-                    int x_end = (int)arrowX;
-                    int y_end = (int)arrowY;
-                    int x_left = x_end - (int)(arrowSize * cos(angle - 0.5));
-                    int y_left = y_end - (int)(arrowSize * sin(angle - 0.5));
-                    int x_right = x_end - (int)(arrowSize * cos(angle + 0.5));
-                    int y_right = y_end - (int)(arrowSize * sin(angle + 0.5));
-                    
-                    QPolygon arrowPoly;
-                    arrowPoly << QPoint(x_end, y_end) << QPoint(x_left, y_left) << QPoint(x_right, y_right);
-                    p.setBrush(QColor("#2c3e50"));
-                    p.setPen(QPen(QColor("#2c3e50"), 2));
-                    p.drawPolygon(arrowPoly);
-                }
-            }
-
-            // Draw weight if weighted
-            if (isWeighted) {
-                double midX = (x1 + x2) / 2;
-                double midY = (y1 + y2) / 2;
-                
-                // Draw background circle for weight
-                p.setBrush(QColor(255, 255, 255, 220));
-                p.setPen(QPen(QColor("#e74c3c"), 2));
-                p.drawEllipse(QPoint((int)midX, (int)midY), 15, 15);
+        // Draw arrow for directed edges
+        if (isDirected && u != v) {
+            double dx = x2 - x1;
+            double dy = y2 - y1;
+            double len = sqrt(dx * dx + dy * dy);
+            if (len > 0) {
+                dx /= len;
+                dy /= len;
+                // Shorten arrow to stop at node edge
+                double arrowX = x2 - 20 * dx;
+                double arrowY = y2 - 20 * dy;
+                double angle = atan2(dy, dx);
+                int arrowSize = 10;
+                int x_end = (int)arrowX;
+                int y_end = (int)arrowY;
+                int x_left = x_end - (int)(arrowSize * cos(angle - 0.5));
+                int y_left = y_end - (int)(arrowSize * sin(angle - 0.5));
+                int x_right = x_end - (int)(arrowSize * cos(angle + 0.5));
+                int y_right = y_end - (int)(arrowSize * sin(angle + 0.5));
                 
-                // Draw weight text
-                p.setPen(QPen(QColor("#e74c3c")));
-                p.setFont(QFont("Arial", 9, QFont::Bold));
-                p.drawText((int)midX - 15, (int)midY - 15, 30, 30, Qt::AlignCenter, QString::number(e.weight));
+                QPolygon arrowPoly;
+                arrowPoly << QPoint(x_end, y_end) << QPoint(x_left, y_left) << QPoint(x_right, y_right);
+                p.setBrush(edgeColor);
+                p.setPen(QPen(edgeColor, 2));
+                p.drawPolygon(arrowPoly);
             }
         }
+
+        // Flow view labels every arc with flow/capacity
+        if (flowView) {
+            QString text = QString::number(flow) + "/" + QString::number(capacity);
+            p.setBrush(QColor(255, 255, 255, 230));
+            p.setPen(QPen(edgeColor, 2));
+            p.drawRoundedRect(QRect((int)midX - 20, (int)midY - 10, 40, 20), 8, 8);
+            p.setPen(QPen(edgeColor.darker(120)));
+            p.setFont(QFont("Arial", 8, QFont::Bold));
+            p.drawText((int)midX - 20, (int)midY - 10, 40, 20, Qt::AlignCenter, text);
+        }
+        // Draw weight if weighted
+        else if (isWeighted) {
+            // Draw background circle for weight
+            p.setBrush(QColor(255, 255, 255, 220));
+            p.setPen(QPen(QColor("#e74c3c"), 2));
+            p.drawEllipse(QPoint((int)midX, (int)midY), 15, 15);
+            
+            // Draw weight text
+            p.setPen(QPen(QColor("#e74c3c")));
+            p.setFont(QFont("Arial", 9, QFont::Bold));
+            p.drawText((int)midX - 15, (int)midY - 15, 30, 30, Qt::AlignCenter, QString::number(weight));
+        }
+
+        // Badge for parallel edges, tucked above the weight bubble
+        if (multiplicity > 1) {
+            QRect badge((int)midX - 14, (int)midY - (isWeighted ? 31 : 9), 28, 16);
+            p.setBrush(QColor("#8e44ad"));
+            p.setPen(Qt::NoPen);
+            p.drawRoundedRect(badge, 7, 7);
+            p.setPen(Qt::white);
+            p.setFont(QFont("Arial", 8, QFont::Bold));
+            p.drawText(badge, Qt::AlignCenter, "×" + QString::number(multiplicity));
+        }
+    };
+
+    if (useCompact && !flowView && compactGraph.vertexCount() == graph.vertexCount()) {
+        // Decode straight from the compressed lists; no per-vertex vectors are touched
+        for (int u = 0; u < compactGraph.vertexCount(); u++)
+            compactGraph.forEachNeighbor(u, [&](int v, int w) { drawArc(u, v, w, -1, -1); });
+    } else {
+        long long arcIndex = 0;
+        for (int u = 0; u < graph.vertexCount(); u++) {
+            const auto& edges = graph.neighbors(u);
+            for (int ei = 0; ei < (int)edges.size(); ei++, arcIndex++)
+                drawArc(u, edges[ei].to, edges[ei].weight, ei, arcIndex);
+        }
     }
 
     // Draw nodes with smaller dynamic size based on vertex count
@@ -847,15 +2214,60 @@ void GraphVisualizer::drawGraph() {
     if (n > 30) { r = 9; fontSize = 6; }
     if (n > 40) { r = 8; fontSize = 6; }
     if (n > 60) { r = 7; fontSize = 5; }
-    
+
+    const std::vector<double>& sizeScores = metricScores(sizeMetricCombo->currentIndex());
+    const std::vector<double>& colorScores = metricScores(colorMetricCombo->currentIndex());
+    int baseR = r;
+
+    if (dense) {
+        // Dots only; the start/highlighted vertex keeps a full marker so it can be found
+        p.setPen(Qt::NoPen);
+        for (int i = 0; i < n; i++) {
+            if ((int)nodePositions.size() <= i || !graph.isAlive(i)) continue;
+            bool isHighlighted = (i == selectedStart || i == highlightedVertex);
+            QColor fill = isHighlighted ? QColor("#e74c3c") : QColor("#3498db");
+            if (!isHighlighted && byColorClass) fill = classColor(coloring.color[i]);
+            else if (!isHighlighted && byCommunity) fill = communityColor(communities.community[i]);
+            else if (!isHighlighted && (int)colorScores.size() == n) fill = QColor::fromHsv((int)(210 * (1.0 - colorScores[i])), 190, 225);
+            double dot = isHighlighted ? 6.0 : (int)sizeScores.size() == n ? 1.0 + 3.0 * sizeScores[i] : 2.0;
+            p.setBrush(fill);
+            p.drawEllipse(QPointF(nodePositions[i].x, nodePositions[i].y), dot, dot);
+        }
+        p.setRenderHint(QPainter::Antialiasing);
+        p.restore();
+        drawDistanceMatrix(p, QRect(0, topOffset, width(), drawHeight));
+        return;
+    }
+
     for (int i = 0; i < n; i++) {
-        if ((int)nodePositions.size() <= i) continue;
+        if ((int)nodePositions.size() <= i || !graph.isAlive(i)) continue;
         int x = (int)nodePositions[i].x;
         int y = (int)nodePositions[i].y;
+        if ((int)sizeScores.size() == n) r = (int)std::lround(baseR * (0.6 + 1.2 * sizeScores[i]));
 
         bool isHighlighted = (i == selectedStart || i == highlightedVertex);
         QColor fill = isHighlighted ? QColor("#e74c3c") : QColor("#3498db");
         QColor border = isHighlighted ? QColor("#c0392b") : QColor("#2980b9");
+        if (!isHighlighted && matchView) {
+            // Left side blue, right side purple; unmatched vertices get a red ring
+            fill = matching.sides.side[i] == 0 ? QColor("#3498db") : QColor("#8e44ad");
+            border = shownMate[i] < 0 ? QColor("#e74c3c") : fill.darker(130);
+        } else if (!isHighlighted && byColorClass) {
+            fill = classColor(coloring.color[i]);
+            border = fill.darker(130);
+        } else if (!isHighlighted && byCommunity) {
+            fill = communityColor(communities.community[i]);
+            border = fill.darker(130);
+        } else if (!isHighlighted && (int)colorScores.size() == n) {
+            // blue (low) -> red (high)
+            fill = QColor::fromHsv((int)(210 * (1.0 - colorScores[i])), 190, 225);
+            border = fill.darker(130);
+        }
+        if (!isHighlighted && flowView) {
+            // Source side of the minimum cut in green, sink side keeps the default blue
+            if (flowResult.sourceSide[i]) { fill = QColor("#27ae60"); border = QColor("#1e8449"); }
+            if (i == flowSource || i == flowSink) border = QColor("#f39c12");
+        }
 
         // Shadow
         p.setBrush(QColor(0, 0, 0, 35));
@@ -874,6 +2286,8 @@ void GraphVisualizer::drawGraph() {
     }
 
     p.restore();
+
+    drawDistanceMatrix(p, QRect(0, topOffset, width(), drawHeight));
 }
 
 void GraphVisualizer::updateStatus(const QString& msg, const QString& kind) {
@@ -884,7 +2298,9 @@ void GraphVisualizer::updateStatus(const QString& msg, const QString& kind) {
     } else {
         statusLabel->setStyleSheet("font-size:13px; color:#3498db; padding:10px; background:#d6eaf8; border-left:4px solid #3498db; border-radius:5px;");
     }
-    statusLabel->setText(msg);
+    // A view switched off by the last change says so after whatever reported the change
+    statusLabel->setText(analyticsNotice.isEmpty() ? msg : msg + " | " + analyticsNotice);
+    analyticsNotice.clear();
     
     QString typeStr;
     switch (graph.getType()) {
@@ -893,5 +2309,5 @@ void GraphVisualizer::updateStatus(const QString& msg, const QString& kind) {
         case UnifiedGraph::UndirectedUnweighted: typeStr = "Undirected Unweighted"; break;
         case UnifiedGraph::UndirectedWeighted: typeStr = "Undirected Weighted"; break;
     }
-    statsLabel->setText("Vertices: " + QString::number(graph.vertexCount()) + " | Type: " + typeStr);
+    statsLabel->setText("Vertices: " + QString::number(graph.liveVertexCount()) + " | Type: " + typeStr);
 }
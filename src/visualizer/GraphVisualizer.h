@@ -12,93 +12,25 @@
 #include <QPushButton>
 #include <QRandomGenerator>
 #include <QScrollBar>
+#include <QImage>
+#include <QColor>
 #include <vector>
-#include <queue>
-#include <stack>
 #include <map>
-
-// Unified graph interface supporting 4 types
-class UnifiedGraph {
-public:
-    enum Type { DirectedUnweighted, DirectedWeighted, UndirectedUnweighted, UndirectedWeighted };
-    
-    struct Edge {
-        int to, weight;
-        Edge(int t, int w = 0) : to(t), weight(w) {}
-    };
-
-    UnifiedGraph(Type t) : type(t) {}
-
-    int addVertex() {
-        adj.emplace_back();
-        return (int)adj.size() - 1;
-    }
-
-    void addEdge(int u, int v, int w = 1) {
-        ensureVertex(std::max(u, v));
-        adj[u].emplace_back(v, w);
-        if (type == UndirectedUnweighted || type == UndirectedWeighted) {
-            adj[v].emplace_back(u, w);
-        }
-    }
-
-    int vertexCount() const { return (int)adj.size(); }
-
-    const std::vector<Edge>& neighbors(int u) const { return adj[u]; }
-
-    void clear() { adj.clear(); }
-
-    std::vector<int> bfs(int start) const {
-        std::vector<int> order;
-        if (start < 0 || start >= (int)adj.size()) return order;
-        std::vector<bool> vis((int)adj.size(), false);
-        std::queue<int> q;
-        q.push(start);
-        vis[start] = true;
-        while (!q.empty()) {
-            int u = q.front();
-            q.pop();
-            order.push_back(u);
-            for (const auto& e : adj[u]) {
-                if (!vis[e.to]) {
-                    vis[e.to] = true;
-                    q.push(e.to);
-                }
-            }
-        }
-        return order;
-    }
-
-    std::vector<int> dfs(int start) const {
-        std::vector<int> order;
-        if (start < 0 || start >= (int)adj.size()) return order;
-        std::vector<bool> vis((int)adj.size(), false);
-        std::stack<int> st;
-        st.push(start);
-        while (!st.empty()) {
-            int u = st.top();
-            st.pop();
-            if (vis[u]) continue;
-            vis[u] = true;
-            order.push_back(u);
-            for (int i = (int)adj[u].size() - 1; i >= 0; --i) {
-                int v = adj[u][i].to;
-                if (!vis[v]) st.push(v);
-            }
-        }
-        return order;
-    }
-
-    Type getType() const { return type; }
-
-private:
-    void ensureVertex(int idx) {
-        while (idx >= (int)adj.size()) addVertex();
-    }
-
-    Type type;
-    std::vector<std::vector<Edge>> adj;
-};
+#include <functional>
+#include "../ds/UnifiedGraph.h"
+#include "../ds/CompressedGraph.h"
+#include "../algo/AllPairsShortestPaths.h"
+#include "../algo/Centrality.h"
+#include "../algo/TriangleCounting.h"
+#include "../algo/MaxFlow.h"
+#include "../algo/GraphReordering.h"
+#include "../algo/GraphGenerators.h"
+#include "../algo/Communities.h"
+#include "../algo/GraphColoring.h"
+#include "../algo/BipartiteMatching.h"
+#include "../algo/KCore.h"
+
+class QPainter;
 
 // Position data for nodes
 struct NodePos {
@@ -115,6 +47,9 @@ private slots:
     void onTypeChanged(int idx);
     void onAddVertex();
     void onAddEdge();
+    void onRemoveVertex();
+    void onRemoveEdge();
+    void onEdgePolicyChanged();
     void onClear();
     void onReload();
     void onBFS();
@@ -123,7 +58,21 @@ private slots:
     void onPlayDFS();
     void onSearchVertex();
     void onToggleLayoutMode();
+    void onToggleOnionLayout();
     void onFitView();
+    void onToggleDistanceMatrix();
+    void onToggleCompactAdjacency();
+    void onMetricMappingChanged();
+    void onCountTriangles();
+    void onToggleMaxFlow();
+    void onFlowMethodChanged();
+    void onCompareMaxFlow();
+    void onReorderVertices();
+    void onGenerateGraph();
+    void onCommunityModeChanged();
+    void onToggleOverview();
+    void onColoringChanged();
+    void onToggleMatching();
 
 private:
     void paintEvent(QPaintEvent* event) override;
@@ -131,12 +80,37 @@ private:
     void drawGraph();
     void computeCircularLayout();
     void computeForceLayout();
+    void computeBipartiteLayout(const std::vector<int>& side);
+    void computeOnionLayout();
     void computeLayout();
+    void relaxForceLayout(int iterations, double heat);
+    NodePos freeSpotFor(int u) const;
+    void applyGraphChanges();
+    void applyEdgePolicy();
     void updateStatus(const QString& msg, const QString& kind = "info");
-    void startTraversalAnimation(const std::vector<int>& seq, const QString& label);
+    void startTraversalAnimation(std::function<bool(TraversalStep&)> next, const QString& name, int start);
+    void stopTraversalAnimation();
+    void invalidateAnalytics();
+    void rebuildDistanceMatrix();
+    bool betweennessTooLarge() const;
+    bool dropOversizedBetweenness();
+    void drawDistanceMatrix(QPainter& p, const QRect& viewport);
+    const std::vector<double>& metricScores(int metric);
+    bool readFlowEndpoints(int& s, int& t) const;
+    void rebuildMaxFlow();
+    void loadGenerated(const GraphGenerators::EdgeBuffer& b);
+    void rebuildCommunities();
+    void rebuildColoring();
+    bool rebuildMatching(bool animate);
+    void stopMatchingAnimation();
+    QColor communityColor(int c) const;
+    void drawCommunityOverview(QPainter& p, const QRect& area);
+    QString formatSequence(const QString& label, int start, const std::vector<int>& seq, long long total = -1) const;
+    int traversalStart() const;
 
     UnifiedGraph graph{UnifiedGraph::DirectedUnweighted};
     std::vector<NodePos> nodePositions;
+    unsigned long long layoutRevision{0}; // graph revision nodePositions reflects
     int selectedStart{-1};
     int highlightedVertex{-1};
 
@@ -144,29 +118,110 @@ private:
     QComboBox* typeCombo;
     QLineEdit* vertexInput;
     QPushButton* addVertexBtn;
+    QLineEdit* removeVertexInput;
+    QPushButton* removeVertexBtn;
     QLineEdit* edgeU, *edgeV, *edgeW;
     QPushButton* addEdgeBtn;
+    QPushButton* removeEdgeBtn;
+    QComboBox* edgePolicyCombo;
+    QCheckBox* selfLoopsCheck;
     QPushButton* clearBtn;
     QPushButton* reloadBtn;
     QLineEdit* searchVertexInput;
     QPushButton* searchVertexBtn;
+    QComboBox* reorderCombo;
+    QPushButton* reorderBtn;
     QPushButton* bfsBtn, *dfsBtn;
     QPushButton* playBFSBtn, *playDFSBtn;
     QPushButton* toggleLayoutBtn;
+    QPushButton* onionBtn;
     QPushButton* fitViewBtn;
+    QPushButton* matrixBtn;
+    QPushButton* compactBtn;
+    QPushButton* generateBtn;
+    QComboBox* sizeMetricCombo;
+    QComboBox* colorMetricCombo;
+    QComboBox* communityCombo;
+    QPushButton* overviewBtn;
+    QComboBox* coloringCombo;
+    QPushButton* trianglesBtn;
+    QLineEdit* flowSourceInput, *flowSinkInput;
+    QComboBox* flowMethodCombo;
+    QPushButton* maxFlowBtn;
+    QPushButton* compareFlowBtn;
+    QPushButton* matchingBtn;
     QScrollBar* vScroll;
     QLabel* statusLabel;
     QLabel* infoLabel;
     QLabel* statsLabel;
     QGroupBox* controlGroup;
 
-    // Animation
+    // Animation: the running traversal is a cursor pulled one visit per tick
     QTimer* traversalTimer{nullptr};
-    std::vector<int> traversalSeq;
-    int traversalIndex{0};
+    std::function<bool(TraversalStep&)> traversalNext;
+    std::vector<int> traversalPrefix; // first visits, for the closing status line
+    long long traversalVisits{0};
 
     bool useForceLayout{false};
+    bool bipartiteLayout{false}; // last full layout put the two sides in columns
+    bool useOnionLayout{false};
+    bool coreLayout{false};      // last full layout was the k-core onion
+    // Onion shells as (core number, radius) around onionCentre, for the guide rings
+    std::vector<std::pair<int, double>> onionShells;
+    NodePos onionCentre;
+    QString coreText;
+    // Size thresholds for generated graphs: the O(n^2) force layout gives way to the static one,
+    // the painter switches to hairline edges and dot nodes, and huge graphs stay headless
+    static constexpr int FORCE_LAYOUT_LIMIT = 600;
+    static constexpr int DENSE_VIEW_LIMIT = 400;
+    static constexpr long long CANVAS_VERTEX_LIMIT = 1000000;
+    static constexpr long long CANVAS_EDGE_LIMIT = 1000000;
+    // The distance matrix holds n^2 ints and takes O(n^3) time on the UI thread
+    static constexpr int DISTANCE_MATRIX_LIMIT = 2000;
+    // Brandes betweenness costs O(V·E); above this product it is not computed
+    static constexpr double BETWEENNESS_WORK_LIMIT = 2e8;
     int scrollOffsetY{0};
+
+    // Compressed adjacency snapshot; when enabled, traversals and the edge pass read it directly
+    bool useCompact{false};
+    CompressedGraph compactGraph;
+
+    // All-pairs distance heat map (one pixel per cell, scaled when painted)
+    bool showDistanceMatrix{false};
+    AllPairsShortestPaths::Result apsp;
+    QImage distanceImage;
+    QString apspSummary;
+    // Set when invalidateAnalytics() switches off a view the graph outgrew; the next status line shows it
+    QString analyticsNotice;
+
+    // Node scores that can drive radius/colour, normalized to [0, 1] and cached per metric
+    enum NodeMetric { MetricNone, MetricDegree, MetricPageRank, MetricBetweenness, MetricClustering, MetricCore };
+    std::map<int, std::vector<double>> metricCache;
+
+    // Communities colour the nodes; the overview draws one disc per community instead of the graph
+    bool showOverview{false};
+    Communities::Result communities;
+    Communities::Summary communitySummary;
+    std::vector<int> overviewOrder; // largest communities first
+    QString communityText;
+
+    // Proper vertex colouring; when active it decides node fill ahead of communities and metrics
+    GraphColoring::Result coloring;
+    QString coloringText;
+
+    // Matching view: shownMate trails matching.mate while the augmenting paths are replayed
+    bool showMatching{false};
+    BipartiteMatching::Result matching;
+    std::vector<int> shownMate;
+    int matchingStep{-1};         // path being highlighted, -1 when idle
+    QTimer* matchingTimer{nullptr};
+    QString matchingText;
+
+    // Max-flow view: saturated arcs and the minimum cut
+    bool showFlow{false};
+    int flowSource{-1}, flowSink{-1};
+    MaxFlow::Result flowResult;
+    QString flowSummary;
 };
 
 #endif // GRAPHVISUALIZER_H
@@ -2,13 +2,24 @@
 #include <QPainter>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
+#include <QInputDialog>
+#include <QFileDialog>
+#include <QFile>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QPolygonF>
+#include <algorithm>
+#include <cmath>
 #include <limits>
 
 TreeVisualizer::TreeVisualizer(QWidget* parent)
     : QWidget(parent), highlightValue(std::numeric_limits<int>::min()) {
     // Seed with some values
-    int seedVals[] = {50, 30, 70, 20, 40, 60, 80};
-    for (int v : seedVals) tree.insert(v);
+    versionLabels.push_back("Empty tree");
+    tree.build({50, 30, 70, 20, 40, 60, 80});
+    versionLabels.push_back("Sample data");
+    relayout();
 
     QVBoxLayout* main = new QVBoxLayout(this);
     main->setSpacing(15);
@@ -60,8 +71,18 @@ TreeVisualizer::TreeVisualizer(QWidget* parent)
     valueInput->setPlaceholderText("Enter integer value");
     valueInput->setMaximumWidth(180);
     valueInput->setStyleSheet("padding:8px; border:2px solid #bdc3c7; border-radius:5px; font-size:12px;");
+    QLabel* balanceLbl = new QLabel("Balancing:");
+    balanceLbl->setStyleSheet("font-size:12px; font-weight:bold; color:#2c3e50;");
+    balanceCombo = new QComboBox();
+    balanceCombo->addItem("Plain BST");
+    balanceCombo->addItem("AVL");
+    balanceCombo->addItem("Red-black");
+    balanceCombo->setStyleSheet("padding:6px; border:2px solid #bdc3c7; border-radius:5px; font-size:12px;");
     inputs->addWidget(valueLbl);
     inputs->addWidget(valueInput);
+    inputs->addSpacing(20);
+    inputs->addWidget(balanceLbl);
+    inputs->addWidget(balanceCombo);
     inputs->addStretch();
     gl->addLayout(inputs);
 
@@ -76,7 +97,10 @@ TreeVisualizer::TreeVisualizer(QWidget* parent)
     searchBtn = new QPushButton("🔍 Search"); searchBtn->setStyleSheet(btnStyle.arg("#3498db", "#2980b9", "#21618c"));
     clearBtn = new QPushButton("🗑 Clear"); clearBtn->setStyleSheet(btnStyle.arg("#95a5a6", "#7f8c8d", "#5d6d7e"));
     reloadBtn = new QPushButton("🔄 Reload"); reloadBtn->setStyleSheet(btnStyle.arg("#3498db", "#2980b9", "#21618c"));
+    pasteBtn = new QPushButton("📋 Paste keys"); pasteBtn->setStyleSheet(btnStyle.arg("#34495e", "#2c3e50", "#212f3d"));
+    fileBtn = new QPushButton("📂 Load file"); fileBtn->setStyleSheet(btnStyle.arg("#34495e", "#2c3e50", "#212f3d"));
     row1->addWidget(insertBtn); row1->addWidget(deleteBtn); row1->addWidget(searchBtn); row1->addWidget(clearBtn); row1->addWidget(reloadBtn);
+    row1->addWidget(pasteBtn); row1->addWidget(fileBtn);
     gl->addLayout(row1);
 
     QHBoxLayout* row2 = new QHBoxLayout();
@@ -84,15 +108,31 @@ TreeVisualizer::TreeVisualizer(QWidget* parent)
     preorderBtn = new QPushButton("Preorder"); preorderBtn->setStyleSheet(btnStyle.arg("#9b59b6", "#8e44ad", "#7d3c98"));
     postorderBtn = new QPushButton("Postorder"); postorderBtn->setStyleSheet(btnStyle.arg("#f39c12", "#e67e22", "#d68910"));
     levelorderBtn = new QPushButton("BFS (Levelorder)"); levelorderBtn->setStyleSheet(btnStyle.arg("#e67e22", "#d35400", "#ba4a00"));
-    row2->addWidget(inorderBtn); row2->addWidget(preorderBtn); row2->addWidget(postorderBtn); row2->addWidget(levelorderBtn); row2->addStretch();
+    fitBtn = new QPushButton("⤢ Fit view"); fitBtn->setStyleSheet(btnStyle.arg("#7f8c8d", "#707b7c", "#616a6b"));
+    row2->addWidget(inorderBtn); row2->addWidget(preorderBtn); row2->addWidget(postorderBtn); row2->addWidget(levelorderBtn); row2->addWidget(fitBtn); row2->addStretch();
     gl->addLayout(row2);
 
     QHBoxLayout* row3 = new QHBoxLayout();
     playDFSBtn = new QPushButton("▶ Play DFS (Preorder)"); playDFSBtn->setStyleSheet(btnStyle.arg("#2ecc71", "#27ae60", "#1e8449"));
     playBFSBtn = new QPushButton("▶ Play BFS"); playBFSBtn->setStyleSheet(btnStyle.arg("#2980b9", "#2471a3", "#1f618d"));
-    row3->addWidget(playDFSBtn); row3->addWidget(playBFSBtn); row3->addStretch();
+    selectBtn = new QPushButton("# Select k"); selectBtn->setStyleSheet(btnStyle.arg("#8e44ad", "#7d3c98", "#6c3483"));
+    rankBtn = new QPushButton("📶 Rank"); rankBtn->setStyleSheet(btnStyle.arg("#16a085", "#138d75", "#117a65"));
+    sizesBtn = new QPushButton("📏 Sizes"); sizesBtn->setCheckable(true);
+    sizesBtn->setStyleSheet(btnStyle.arg("#7f8c8d", "#707b7c", "#616a6b") + "QPushButton:checked { background-color:#e67e22; }");
+    row3->addWidget(playDFSBtn); row3->addWidget(playBFSBtn); row3->addWidget(selectBtn); row3->addWidget(rankBtn); row3->addWidget(sizesBtn); row3->addStretch();
     gl->addLayout(row3);
 
+    // History: undo/redo and a timeline over every version
+    QHBoxLayout* row4 = new QHBoxLayout();
+    undoBtn = new QPushButton("↶ Undo"); undoBtn->setStyleSheet(btnStyle.arg("#34495e", "#2c3e50", "#212f3d"));
+    redoBtn = new QPushButton("↷ Redo"); redoBtn->setStyleSheet(btnStyle.arg("#34495e", "#2c3e50", "#212f3d"));
+    timeline = new QSlider(Qt::Horizontal);
+    timeline->setPageStep(1);
+    versionLabel = new QLabel();
+    versionLabel->setStyleSheet("font-size:12px; color:#2c3e50;");
+    row4->addWidget(undoBtn); row4->addWidget(redoBtn); row4->addWidget(timeline, 1); row4->addWidget(versionLabel);
+    gl->addLayout(row4);
+
     controlGroup->setLayout(gl);
     main->addWidget(controlGroup);
 
@@ -106,18 +146,40 @@ TreeVisualizer::TreeVisualizer(QWidget* parent)
     connect(searchBtn, &QPushButton::clicked, this, &TreeVisualizer::onSearch);
     connect(clearBtn, &QPushButton::clicked, this, &TreeVisualizer::onClear);
     connect(reloadBtn, &QPushButton::clicked, this, &TreeVisualizer::onReload);
+    connect(pasteBtn, &QPushButton::clicked, this, &TreeVisualizer::onPasteKeys);
+    connect(fileBtn, &QPushButton::clicked, this, &TreeVisualizer::onLoadFile);
     connect(inorderBtn, &QPushButton::clicked, this, &TreeVisualizer::onInorder);
     connect(preorderBtn, &QPushButton::clicked, this, &TreeVisualizer::onPreorder);
     connect(postorderBtn, &QPushButton::clicked, this, &TreeVisualizer::onPostorder);
     connect(levelorderBtn, &QPushButton::clicked, this, &TreeVisualizer::onLevelorder);
     connect(playDFSBtn, &QPushButton::clicked, this, &TreeVisualizer::onPlayDFS);
     connect(playBFSBtn, &QPushButton::clicked, this, &TreeVisualizer::onPlayBFS);
+    connect(selectBtn, &QPushButton::clicked, this, &TreeVisualizer::onSelect);
+    connect(rankBtn, &QPushButton::clicked, this, &TreeVisualizer::onRank);
+    connect(sizesBtn, &QPushButton::clicked, this, &TreeVisualizer::onToggleSizes);
+    connect(fitBtn, &QPushButton::clicked, this, &TreeVisualizer::onFitView);
+    connect(undoBtn, &QPushButton::clicked, this, &TreeVisualizer::onUndo);
+    connect(redoBtn, &QPushButton::clicked, this, &TreeVisualizer::onRedo);
+    connect(timeline, &QSlider::valueChanged, this, &TreeVisualizer::onTimeline);
+    connect(balanceCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &TreeVisualizer::onBalanceChanged);
+
+    morphTimer = new QTimer(this);
+    morphTimer->setInterval(30);
+    connect(morphTimer, &QTimer::timeout, this, [this]() {
+        morphT = std::min(1.0, morphT + 0.08);
+        if (morphT >= 1.0) {
+            morphTimer->stop();
+            morphFrom.clear();
+            rotatedValues.clear();
+        }
+        update();
+    });
+    syncTimeline();
 }
 
 void TreeVisualizer::paintEvent(QPaintEvent* e) { QWidget::paintEvent(e); drawTree(); }
 
-void TreeVisualizer::drawTree() {
-    QPainter p(this); p.setRenderHint(QPainter::Antialiasing);
+QRect TreeVisualizer::treeArea() const {
     // Compute a top offset so drawing stays below controls (raised slightly to show deeper leaves)
     int controlsBottom = 0;
     if (statusLabel && statusLabel->isVisible()) {
@@ -135,90 +197,268 @@ void TreeVisualizer::drawTree() {
     int drawWidth = width() - 2 * sideMargin;
     if (drawHeight < 80) drawHeight = 80;
     if (drawWidth < 100) drawWidth = 100;
+    return QRect(sideMargin, topOffset, drawWidth, drawHeight);
+}
+
+// Recomputes the tidy layout; call after every change to the tree's shape
+void TreeVisualizer::relayout() {
+    layout = TidyTreeLayout::compute(tree);
+}
+
+// Unscaled drawing: one layout unit = COLUMN px, one level = LEVEL px, nodes of RADIUS px
+static const double COLUMN = 60, LEVEL = 100, MARGIN = 30, RADIUS = 26;
+static const double MAX_SCALE = 3.0;
+// Subtrees whose box is smaller than this both ways on screen are drawn as a single glyph
+static const double GLYPH_PX = 12;
+// Above this many nodes, changes are not animated: the glide is not worth an O(n) snapshot
+static const int MORPH_LIMIT = 2000;
+
+QPointF TreeVisualizer::View::at(double x, double depth) const {
+    return origin + QPointF((x - minX) * COLUMN + MARGIN, depth * LEVEL + MARGIN) * scale;
+}
+
+// Fits the whole tree into the drawing area at zoom 1, centred horizontally, then applies zoom and pan
+TreeVisualizer::View TreeVisualizer::currentView() const {
+    QRect area = treeArea();
+    double width = (layout.maxX - layout.minX) * COLUMN + 2 * MARGIN;
+    double height = std::max(0, layout.height) * LEVEL + 2 * MARGIN;
+    double fit = std::min({1.0, area.width() / width, area.height() / height});
+    View view;
+    view.minX = layout.minX;
+    view.scale = fit * zoom;
+    view.origin = QPointF(area.left() + (area.width() - width * view.scale) / 2, area.top()) + pan;
+    return view;
+}
+
+void TreeVisualizer::resetView() {
+    zoom = 1.0;
+    pan = QPointF();
+}
+
+void TreeVisualizer::onFitView() { resetView(); update(); }
+
+// Zooms about the cursor: the layout point under it stays put
+void TreeVisualizer::wheelEvent(QWheelEvent* e) {
+    QPointF cursor = e->position();
+    if (tree.root() == PersistentTree::NIL || !treeArea().contains(cursor.toPoint())) { e->ignore(); return; }
+    View before = currentView();
+    QPointF anchor = (cursor - before.origin) / before.scale;
+    double fit = before.scale / zoom;
+    zoom = std::clamp(zoom * std::pow(1.0015, e->angleDelta().y()), 0.5, std::max(1.0, MAX_SCALE / fit));
+    View after = currentView();
+    pan += cursor - (after.origin + anchor * after.scale);
+    e->accept();
+    update();
+}
+
+void TreeVisualizer::mousePressEvent(QMouseEvent* e) {
+    if (e->button() != Qt::LeftButton || !treeArea().contains(e->pos())) { QWidget::mousePressEvent(e); return; }
+    dragging = true;
+    dragFrom = e->position();
+    setCursor(Qt::ClosedHandCursor);
+}
+
+void TreeVisualizer::mouseMoveEvent(QMouseEvent* e) {
+    if (!dragging) { QWidget::mouseMoveEvent(e); return; }
+    pan += e->position() - dragFrom;
+    dragFrom = e->position();
+    update();
+}
+
+void TreeVisualizer::mouseReleaseEvent(QMouseEvent* e) {
+    if (!dragging) { QWidget::mouseReleaseEvent(e); return; }
+    dragging = false;
+    unsetCursor();
+}
+
+void TreeVisualizer::mouseDoubleClickEvent(QMouseEvent* e) {
+    if (!treeArea().contains(e->pos())) { QWidget::mouseDoubleClickEvent(e); return; }
+    onFitView();
+}
+
+void TreeVisualizer::drawTree() {
+    QPainter p(this); p.setRenderHint(QPainter::Antialiasing);
+    QRect area = treeArea();
 
-    if (!tree.getRoot()) {
+    if (tree.root() == PersistentTree::NIL) {
         p.setPen(QPen(QColor("#95a5a6"), 2)); p.setFont(QFont("Arial", 16, QFont::Bold));
-        QRect emptyRect(sideMargin, topOffset, drawWidth, drawHeight);
-        p.drawText(emptyRect, Qt::AlignCenter,
+        p.drawText(area, Qt::AlignCenter,
                    "⚠️ Tree is empty\n\nInsert values to build the BST");
         return;
     }
+
+    View view = currentView();
+    double radius = RADIUS * view.scale;
+    // While a change animates, nodes are between their boxes, so every node is drawn (there are
+    // at most MORPH_LIMIT of them)
+    bool animating = morphT < 1.0 && !morphFrom.empty();
+    double t = 1.0 - (1.0 - morphT) * (1.0 - morphT); // ease out
+    auto centre = [&](int n) {
+        QPointF to(layout.x[n], layout.depth[n]);
+        if (animating) {
+            auto from = morphFrom.find(tree.node(n).value);
+            if (from != morphFrom.end()) to = from->second + (to - from->second) * t;
+        }
+        return view.at(to.x(), to.y());
+    };
     
-    // Compute scaling based on tree dimensions
-    int treeHeight = tree.height();
-    int treeSize = tree.size();
-    
-    // Estimate tree width based on size
-    int estimatedWidth = std::max(200, treeSize * 60);
-    int estimatedHeight = 60 + (treeHeight * 100);
-    
-    double scaleX = 1.0;
-    double scaleY = 1.0;
-    
-    if (estimatedWidth > drawWidth) {
-        scaleX = (double)drawWidth / (double)estimatedWidth;
-        scaleX = std::max(0.2, std::min(1.0, scaleX));
+    // Set clipping region to prevent drawing outside bounds
+    p.setClipRect(area);
+
+    // Descend from the root, skipping subtrees whose box misses the area and folding those too
+    // small to see, so the work follows what is on screen rather than the size of the tree.
+    // Edges are drawn on the way down, nodes and glyphs afterwards on top of them.
+    bool levelsMerge = LEVEL * view.scale < 2; // levels this close cannot be told apart
+    std::vector<int> nodes, glyphs;
+    std::vector<int> pending{tree.root()};
+    p.setPen(QPen(QColor("#34495e"), std::max(0.5, 2 * view.scale)));
+    while (!pending.empty()) {
+        int n = pending.back();
+        pending.pop_back();
+        const PersistentTree::Node& node = tree.node(n);
+        if (!animating) {
+            QRectF box = QRectF(view.at(layout.spanMin[n], layout.depth[n]), view.at(layout.spanMax[n], layout.bottom[n]))
+                             .adjusted(-radius, -radius, radius, radius);
+            if (!box.intersects(area)) continue;
+            // Children drawn within a couple of pixels of their parent fold too, however long the
+            // subtree is: a long chain far out is no more readable than a small bush
+            bool childrenOnTop = levelsMerge;
+            for (int child : {node.left, node.right}) {
+                if (child != PersistentTree::NIL && std::abs(layout.x[child] - layout.x[n]) * COLUMN * view.scale >= 2) childrenOnTop = false;
+            }
+            if (node.size > 1 && ((box.width() < GLYPH_PX && box.height() < GLYPH_PX) || childrenOnTop)) {
+                glyphs.push_back(n);
+                continue;
+            }
+        }
+        nodes.push_back(n);
+        for (int child : {node.left, node.right}) {
+            if (child == PersistentTree::NIL) continue;
+            p.drawLine(centre(n), centre(child));
+            pending.push_back(child);
+        }
     }
-    
-    if (estimatedHeight > drawHeight) {
-        scaleY = (double)drawHeight / (double)estimatedHeight;
-        scaleY = std::max(0.3, std::min(1.0, scaleY));
+    for (int n : glyphs) {
+        drawCollapsed(p, n, view.at(layout.x[n], layout.depth[n]),
+                      QRectF(view.at(layout.spanMin[n], layout.depth[n]), view.at(layout.spanMax[n], layout.bottom[n])));
     }
-    
-    // Use minimum scale to maintain aspect ratio
-    double scale = std::min(scaleX, scaleY);
-    
-    // Set clipping region to prevent drawing outside bounds
-    p.setClipRect(sideMargin, topOffset, drawWidth, drawHeight);
-    
-    p.save();
-    p.translate(sideMargin, topOffset);
-    p.scale(scale, scale);
-    
-    int startY = 30; // start higher to keep bottom leaves visible
-    int centerX = (int)(drawWidth / scale) / 2;
-    int hGap = std::max(80, (int)(drawWidth / scale) / 5);
-    drawNode(p, tree.getRoot(), centerX, startY, hGap, 0);
-    
-    p.restore();
+    for (int n : nodes) drawNode(p, n, centre(n), view.scale);
+
+    p.setClipping(false);
+    p.setPen(QColor("#7f8c8d")); p.setFont(QFont("Arial", 9));
+    p.drawText(area.left(), area.bottom() + 4, area.width(), 20, Qt::AlignLeft,
+               "Zoom " + QString::number(view.scale * 100, 'g', 3) + "% · " + QString::number(nodes.size()) + " of " +
+               QString::number(tree.size()) + " nodes drawn, " + QString::number(glyphs.size()) +
+               " subtrees folded · wheel to zoom, drag to pan, double-click to fit");
 }
 
-void TreeVisualizer::drawNode(QPainter& p, BSTree::Node* n, int x, int y, int hGap, int depth) {
-    if (!n) return;
-    int childY = y + 100;
-    int nextGap = std::max(40, hGap / 2);
+// A subtree too small to show node by node: a wedge from its root down over its box, more opaque
+// the more nodes it stands for
+void TreeVisualizer::drawCollapsed(QPainter& p, int node, QPointF apex, const QRectF& box) {
+    const PersistentTree::Node& n = tree.node(node);
+    // Keep even a one-pixel subtree visible
+    double left = std::min(box.left(), apex.x() - 1.5), right = std::max(box.right(), apex.x() + 1.5);
+    double bottom = std::max(box.bottom(), apex.y() + 3);
+    QPolygonF wedge;
+    wedge << apex << QPointF(left, bottom) << QPointF(right, bottom);
+    bool redBlack = tree.balance() == PersistentTree::Balance::RedBlack;
+    QColor fill = redBlack ? QColor("#2c3e50") : QColor("#27ae60");
+    fill.setAlpha(std::min(255, 90 + 20 * (int)std::log2((double)n.size)));
+    p.setPen(Qt::NoPen); p.setBrush(fill);
+    p.drawPolygon(wedge);
+}
 
-    // Edges first
-    if (n->left) {
-        int lx = x - hGap; int ly = childY;
-        p.setPen(QPen(QColor("#34495e"), 2));
-        p.drawLine(x, y, lx, ly);
-        drawNode(p, n->left, lx, ly, nextGap, depth + 1);
-    }
-    if (n->right) {
-        int rx = x + hGap; int ry = childY;
-        p.setPen(QPen(QColor("#34495e"), 2));
-        p.drawLine(x, y, rx, ry);
-        drawNode(p, n->right, rx, ry, nextGap, depth + 1);
-    }
+void TreeVisualizer::drawNode(QPainter& p, int node, QPointF c, double scale) {
+    const PersistentTree::Node& n = tree.node(node);
 
     // Node circle
     int r = 26;
-    bool hi = (n->value == highlightValue);
-    QColor fill = hi ? QColor("#e74c3c") : QColor("#2ecc71");
-    QColor border = hi ? QColor("#c0392b") : QColor("#27ae60");
+    bool hi = (n.value == highlightValue);
+    bool redBlack = tree.balance() == PersistentTree::Balance::RedBlack;
+    QColor fill = QColor("#2ecc71");
+    QColor border = QColor("#27ae60");
+    if (redBlack) {
+        fill = n.red ? QColor("#e74c3c") : QColor("#2c3e50");
+        border = n.red ? QColor("#c0392b") : QColor("#17202a");
+    }
+    if (hi) {
+        fill = redBlack ? QColor("#f39c12") : QColor("#e74c3c");
+        border = redBlack ? QColor("#d68910") : QColor("#c0392b");
+    }
+    bool rotated = std::find(rotatedValues.begin(), rotatedValues.end(), n.value) != rotatedValues.end();
+    bool onPath = std::find(pathValues.begin(), pathValues.end(), n.value) != pathValues.end();
+    if (onPath && !rotated) border = QColor("#3498db");
+
+    // Far out a node is a dot: skip the shadow, text and badges nobody could read
+    if (r * scale < 4) {
+        p.setPen(Qt::NoPen); p.setBrush(rotated ? QColor("#e67e22") : onPath && !hi ? border : fill);
+        p.drawEllipse(c, std::max(1.5, r * scale), std::max(1.5, r * scale));
+        return;
+    }
+
+    p.save();
+    p.translate(c);
+    p.scale(scale, scale);
 
     // Shadow
     p.setBrush(QColor(0,0,0,35)); p.setPen(Qt::NoPen);
-    p.drawEllipse(QPoint(x+3,y+3), r, r);
+    p.drawEllipse(QPoint(3,3), r, r);
 
     // Circle
-    p.setBrush(fill); p.setPen(QPen(border, 3));
-    p.drawEllipse(QPoint(x,y), r, r);
+    p.setBrush(fill); p.setPen(QPen(rotated ? QColor("#e67e22") : border, rotated || onPath ? 6 : 3));
+    p.drawEllipse(QPoint(0,0), r, r);
 
     // Value text
+    if (r * scale < 8) { p.restore(); return; }
     p.setPen(Qt::white); p.setFont(QFont("Arial", 12, QFont::Bold));
-    p.drawText(x - r, y - r, 2*r, 2*r, Qt::AlignCenter, QString::number(n->value));
+    p.drawText(-r, -r, 2*r, 2*r, Qt::AlignCenter, QString::number(n.value));
+
+    // Subtree size, as cached by the tree
+    if (showSizes) {
+        p.setPen(QColor("#7f8c8d")); p.setFont(QFont("Arial", 9, QFont::Bold));
+        p.drawText(-r, r + 2, 2*r, 16, Qt::AlignCenter, "n=" + QString::number(n.size));
+    }
+    p.restore();
+}
+
+// Remembers where every node is drawn now; call before changing the tree
+void TreeVisualizer::beginMorph() {
+    morphFrom.clear();
+    if (tree.size() > MORPH_LIMIT) return;
+    morphFrom.reserve(tree.size());
+    std::vector<int> pending;
+    if (tree.root() != PersistentTree::NIL) pending.push_back(tree.root());
+    while (!pending.empty()) {
+        int n = pending.back();
+        pending.pop_back();
+        const PersistentTree::Node& node = tree.node(n);
+        morphFrom[node.value] = QPointF(layout.x[n], layout.depth[n]);
+        if (node.left != PersistentTree::NIL) pending.push_back(node.left);
+        if (node.right != PersistentTree::NIL) pending.push_back(node.right);
+    }
+}
+
+void TreeVisualizer::startMorph() {
+    rotatedValues.clear();
+    for (const PersistentTree::Rotation& r : tree.lastRotations()) {
+        rotatedValues.push_back(r.pivot);
+        rotatedValues.push_back(r.child);
+    }
+    morphT = 0.0;
+    morphTimer->start();
+    update();
+}
+
+QString TreeVisualizer::describeRotations() const {
+    const std::vector<PersistentTree::Rotation>& rotations = tree.lastRotations();
+    if (rotations.empty()) return QString();
+    QString text = " | " + QString::number(rotations.size()) + (rotations.size() == 1 ? " rotation: " : " rotations: ");
+    for (size_t i = 0; i < rotations.size() && i < 6; ++i) {
+        if (i) text += ", ";
+        text += QString(rotations[i].left ? "left" : "right") + " at " + QString::number(rotations[i].pivot);
+    }
+    if (rotations.size() > 6) text += ", …";
+    return text;
 }
 
 void TreeVisualizer::updateStatus(const QString& m, const QString& kind) {
@@ -242,16 +482,23 @@ void TreeVisualizer::updateStatus(const QString& m, const QString& kind) {
 void TreeVisualizer::onInsert() {
     bool ok; int v = valueInput->text().toInt(&ok);
     if (!ok || valueInput->text().isEmpty()) { updateStatus("Please enter a valid integer value", "error"); return; }
-    if (tree.height() >= 7) { updateStatus("❌ Tree height limit reached (max 7). Cannot insert more values.", "error"); return; }
-    if (!tree.insert(v)) { updateStatus("Value already exists in tree", "error"); return; }
-    highlightValue = v; valueInput->clear(); updateStatus("Inserted " + QString::number(v), "success"); update();
+    pathValues.clear();
+    beginMorph();
+    if (!tree.insert(v)) { morphFrom.clear(); updateStatus("Value already exists in tree", "error"); return; }
+    recordVersion("Inserted " + QString::number(v));
+    relayout();
+    highlightValue = v; valueInput->clear(); updateStatus("Inserted " + QString::number(v) + describeRotations(), "success"); startMorph();
 }
 
 void TreeVisualizer::onDelete() {
     bool ok; int v = valueInput->text().toInt(&ok);
     if (!ok || valueInput->text().isEmpty()) { updateStatus("Please enter a valid integer value", "error"); return; }
-    if (!tree.remove(v)) { updateStatus("Value not found in tree", "error"); return; }
-    highlightValue = std::numeric_limits<int>::min(); updateStatus("Deleted " + QString::number(v), "success"); update();
+    pathValues.clear();
+    beginMorph();
+    if (!tree.remove(v)) { morphFrom.clear(); updateStatus("Value not found in tree", "error"); return; }
+    recordVersion("Deleted " + QString::number(v));
+    relayout();
+    highlightValue = std::numeric_limits<int>::min(); updateStatus("Deleted " + QString::number(v) + describeRotations(), "success"); startMorph();
 }
 
 void TreeVisualizer::onSearch() {
@@ -264,13 +511,15 @@ void TreeVisualizer::onSearch() {
 
 void TreeVisualizer::onClear() {
     if (tree.size() == 0) { updateStatus("Tree is already empty", "info"); return; }
-    tree.clear(); highlightValue = std::numeric_limits<int>::min(); updateStatus("Cleared all nodes", "success"); update();
+    tree.clear(); recordVersion("Cleared"); relayout(); resetView(); pathValues.clear(); highlightValue = std::numeric_limits<int>::min(); updateStatus("Cleared all nodes", "success"); update();
 }
 
 void TreeVisualizer::onReload() {
-    tree.clear();
-    int seedVals[] = {50, 30, 70, 20, 40, 60, 80};
-    for (int v : seedVals) tree.insert(v);
+    pathValues.clear();
+    tree.build({50, 30, 70, 20, 40, 60, 80});
+    recordVersion("Sample data");
+    relayout();
+    resetView();
     highlightValue = std::numeric_limits<int>::min();
     updateStatus("BST reloaded with sample data", "success");
     update();
@@ -306,5 +555,140 @@ void TreeVisualizer::startTraversalAnimation(const std::vector<int>& seq, const
     traversalTimer->start();
 }
 
+static QString joinPath(const std::vector<int>& path) {
+    QString s; for (size_t i=0;i<path.size();++i){ if(i) s += " → "; s += QString::number(path[i]); } return s;
+}
+
+// k is 1-based in the UI; the descent uses the cached subtree sizes to skip whole subtrees
+void TreeVisualizer::onSelect() {
+    bool ok; int k = valueInput->text().toInt(&ok);
+    if (!ok || k < 1 || k > tree.size()) { updateStatus("Enter k between 1 and " + QString::number(tree.size()), "error"); return; }
+    highlightValue = tree.select(k - 1, &pathValues);
+    updateStatus("Select k=" + QString::number(k) + ": " + QString::number(highlightValue) + " | path " + joinPath(pathValues), "success");
+    update();
+}
+
+void TreeVisualizer::onRank() {
+    bool ok; int v = valueInput->text().toInt(&ok);
+    if (!ok || valueInput->text().isEmpty()) { updateStatus("Please enter a valid integer value", "error"); return; }
+    int smaller = tree.rank(v, &pathValues);
+    if (tree.contains(v)) {
+        highlightValue = v;
+        updateStatus(QString::number(v) + " has rank " + QString::number(smaller + 1) + " (" + QString::number(smaller) +
+                     " smaller keys) | path " + joinPath(pathValues), "success");
+    } else {
+        highlightValue = std::numeric_limits<int>::min();
+        updateStatus(QString::number(v) + " is not in the tree; " + QString::number(smaller) + " keys are smaller", "info");
+    }
+    update();
+}
+
+void TreeVisualizer::onToggleSizes() {
+    showSizes = !showSizes;
+    sizesBtn->setChecked(showSizes);
+    update();
+}
+
+// Rebuilds the current keys under the chosen balancing as a new version, so undo switches back
+void TreeVisualizer::onBalanceChanged(int index) {
+    auto balance = (PersistentTree::Balance)index;
+    if (balance == tree.balance()) return;
+    pathValues.clear();
+    beginMorph();
+    tree.rebalance(balance);
+    recordVersion(balanceCombo->currentText());
+    relayout();
+    updateStatus(balanceCombo->currentText() + ": " + QString::number(tree.size()) + " keys, height " + QString::number(tree.height()), "success");
+    startMorph();
+    rotatedValues.clear();
+}
+
+void TreeVisualizer::onPasteKeys() {
+    bool ok;
+    QString text = QInputDialog::getMultiLineText(this, "Paste keys", "Integers separated by spaces, commas or new lines:", QString(), &ok);
+    if (ok) importKeys(text, "pasted text");
+}
+
+void TreeVisualizer::onLoadFile() {
+    QString path = QFileDialog::getOpenFileName(this, "Load keys", QString(), "Text files (*.txt *.csv);;All files (*)");
+    if (path.isEmpty()) return;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) { updateStatus("Cannot open " + path, "error"); return; }
+    importKeys(QString::fromUtf8(file.readAll()), QFileInfo(path).fileName());
+}
+
+// Replaces the tree with the parsed keys in one balanced bulk build rather than key-by-key inserts
+void TreeVisualizer::importKeys(const QString& text, const QString& source) {
+    std::vector<int> keys;
+    int skipped = 0;
+    const auto tokens = text.split(QRegularExpression("[\\s,;]+"), Qt::SkipEmptyParts);
+    keys.reserve(tokens.size());
+    for (const QString& token : tokens) {
+        bool ok; int v = token.toInt(&ok);
+        if (ok) keys.push_back(v); else ++skipped;
+    }
+    if (keys.empty()) { updateStatus("No integers found in " + source, "error"); return; }
+
+    if (traversalTimer) traversalTimer->stop();
+    morphTimer->stop(); morphFrom.clear(); rotatedValues.clear(); pathValues.clear();
+    highlightValue = std::numeric_limits<int>::min();
+    QElapsedTimer timer; timer.start();
+    int kept = tree.build(std::move(keys));
+    recordVersion("Built " + QString::number(kept) + " keys from " + source);
+    relayout();
+    resetView();
+    QString msg = "Built " + QString::number(kept) + " keys from " + source + " in " + QString::number(timer.elapsed()) +
+                  " ms, height " + QString::number(tree.height());
+    int duplicates = (int)tokens.size() - skipped - kept;
+    if (duplicates > 0) msg += " | " + QString::number(duplicates) + " duplicates dropped";
+    if (skipped > 0) msg += " | " + QString::number(skipped) + " invalid tokens skipped";
+    updateStatus(msg, "success");
+    update();
+}
+
 void TreeVisualizer::onPlayDFS(){ startTraversalAnimation(tree.preorder(), "DFS (Preorder)"); }
 void TreeVisualizer::onPlayBFS(){ startTraversalAnimation(tree.levelorder(), "BFS (Levelorder)"); }
+
+// Labels the version the last change published; anything that was redoable is gone now, and so
+// are any old versions the tree dropped to cap its history
+void TreeVisualizer::recordVersion(const QString& label) {
+    versionLabels.erase(versionLabels.begin(), versionLabels.begin() + (tree.droppedVersions() - labelsDropped));
+    labelsDropped = tree.droppedVersions();
+    versionLabels.resize(tree.version());
+    versionLabels.push_back(label);
+    syncTimeline();
+}
+
+void TreeVisualizer::syncTimeline() {
+    timeline->blockSignals(true);
+    timeline->setRange(0, tree.versionCount() - 1);
+    timeline->setValue(tree.version());
+    timeline->blockSignals(false);
+    undoBtn->setEnabled(tree.canUndo());
+    redoBtn->setEnabled(tree.canRedo());
+    // Numbered since the start of the session, so a version keeps its number when older ones go
+    int first = tree.droppedVersions();
+    versionLabel->setText("Version " + QString::number(first + tree.version()) + " / " + QString::number(first + tree.versionCount() - 1) +
+                          " · " + QString::number(tree.slotCount()) + " nodes in all");
+}
+
+// Switching versions is O(1) in the tree; only the layout is redone, and nodes glide as after an edit
+void TreeVisualizer::showVersion(int version) {
+    if (version < 0 || version >= tree.versionCount() || version == tree.version()) return;
+    if (traversalTimer) traversalTimer->stop();
+    pathValues.clear();
+    highlightValue = std::numeric_limits<int>::min();
+    beginMorph();
+    tree.checkout(version);
+    relayout();
+    balanceCombo->blockSignals(true);
+    balanceCombo->setCurrentIndex((int)tree.balance());
+    balanceCombo->blockSignals(false);
+    syncTimeline();
+    updateStatus("Version " + QString::number(tree.droppedVersions() + tree.version()) + ": " + versionLabels[tree.version()], "info");
+    startMorph();
+}
+
+void TreeVisualizer::onUndo() { showVersion(tree.version() - 1); }
+void TreeVisualizer::onRedo() { showVersion(tree.version() + 1); }
+void TreeVisualizer::onTimeline(int version) { showVersion(version); }
@@ -7,7 +7,15 @@
 #include <QLabel>
 #include <QGroupBox>
 #include <QTimer>
-#include "../ds/Tree.h"
+#include <QComboBox>
+#include <QSlider>
+#include <QPointF>
+#include <QRectF>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <unordered_map>
+#include "../ds/PersistentTree.h"
+#include "../algo/TidyTreeLayout.h"
 
 class TreeVisualizer : public QWidget {
     Q_OBJECT
@@ -26,30 +34,81 @@ private slots:
     void onLevelorder();
     void onPlayDFS();
     void onPlayBFS();
+    void onBalanceChanged(int index);
+    void onSelect();
+    void onRank();
+    void onToggleSizes();
+    void onPasteKeys();
+    void onLoadFile();
+    void onFitView();
+    void onUndo();
+    void onRedo();
+    void onTimeline(int version);
 
 private:
+    // Layout units to widget pixels under the current zoom and pan
+    struct View {
+        QPointF origin; // where layout x = minX on level 0 lands, before the margin
+        double minX{0};
+        double scale{1};
+        QPointF at(double x, double depth) const;
+    };
+
     void paintEvent(QPaintEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void mouseDoubleClickEvent(QMouseEvent* event) override;
     void drawTree();
-    void drawNode(class QPainter& p, BSTree::Node* node, int x, int y, int hGap, int depth);
+    void drawNode(class QPainter& p, int node, QPointF centre, double scale);
+    void drawCollapsed(class QPainter& p, int node, QPointF apex, const QRectF& box);
+    void relayout();
+    View currentView() const;
+    void resetView();
+    QRect treeArea() const;
+    void beginMorph();
+    void startMorph();
+    QString describeRotations() const;
     void updateStatus(const QString& message, const QString& kind);
     void startTraversalAnimation(const std::vector<int>& sequence, const QString& label);
+    void importKeys(const QString& text, const QString& source);
+    void recordVersion(const QString& label);
+    void showVersion(int version);
+    void syncTimeline();
 
-    BSTree tree;
+    // Every change is a new version of the persistent tree; undo, redo and the timeline only
+    // switch which version is shown
+    PersistentTree tree;
+    std::vector<QString> versionLabels; // what made each version the tree still keeps
+    int labelsDropped{0};               // tree.droppedVersions() when versionLabels was last trimmed
+    TidyTreeLayout layout; // recomputed after each change, read by every paint
     int highlightValue;
 
     // UI
     QLineEdit* valueInput;
+    QComboBox* balanceCombo;
     QPushButton* insertBtn;
     QPushButton* deleteBtn;
     QPushButton* searchBtn;
     QPushButton* clearBtn;
     QPushButton* reloadBtn;
+    QPushButton* pasteBtn;
+    QPushButton* fileBtn;
     QPushButton* inorderBtn;
     QPushButton* preorderBtn;
     QPushButton* postorderBtn;
     QPushButton* levelorderBtn;
     QPushButton* playDFSBtn;
     QPushButton* playBFSBtn;
+    QPushButton* selectBtn;
+    QPushButton* rankBtn;
+    QPushButton* sizesBtn;
+    QPushButton* fitBtn;
+    QPushButton* undoBtn;
+    QPushButton* redoBtn;
+    QSlider* timeline;
+    QLabel* versionLabel;
     QLabel* statusLabel;
     QLabel* infoLabel;
     QLabel* sizeLabel;
@@ -61,6 +120,24 @@ private:
     QTimer* traversalTimer{nullptr};
     std::vector<int> traversalSeq;
     int traversalIndex{0};
+
+    // Zoom is relative to the scale that fits the whole tree; pan is in pixels
+    double zoom{1.0};
+    QPointF pan;
+    bool dragging{false};
+    QPointF dragFrom;
+
+    // Change animation: node centres before the last insert/remove glide to their new places,
+    // with the nodes involved in rotations outlined until it ends. Positions are in layout units
+    // (x, level), so zooming or panning mid-animation keeps them in step.
+    QTimer* morphTimer{nullptr};
+    std::unordered_map<int, QPointF> morphFrom;
+    double morphT{1.0};
+    std::vector<int> rotatedValues;
+
+    // Order statistics: keys visited by the last select/rank, and subtree-size badges
+    std::vector<int> pathValues;
+    bool showSizes{false};
 };
 
 #endif // TREEVISUALIZER_H
@@ -0,0 +1,179 @@
+// PersistentTree against BSTree: both run the TreeBalancing rules, so the same operations must
+// give the same shapes, and every older version must stay as it was.
+//
+//   persistent_tree_test    exits non-zero on the first failed check
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include "../src/ds/PersistentTree.h"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            ++failures;                                                      \
+        }                                                                    \
+    } while (0)
+
+// Preorder of every node's key, colour, children present and cached size and height
+template <class Tree>
+static std::vector<long long> shape(const Tree& t) {
+    std::vector<long long> out;
+    std::vector<int> stack;
+    if (t.root() != Tree::NIL) stack.push_back(t.root());
+    while (!stack.empty()) {
+        const auto& n = t.node(stack.back());
+        stack.pop_back();
+        out.push_back((long long)n.value * 8 + n.red + (n.left != Tree::NIL) * 2 + (n.right != Tree::NIL) * 4);
+        out.push_back((long long)n.size * 1000 + n.height);
+        if (n.right != Tree::NIL) stack.push_back(n.right);
+        if (n.left != Tree::NIL) stack.push_back(n.left);
+    }
+    return out;
+}
+
+static unsigned long long fingerprint(const PersistentTree& t) {
+    unsigned long long h = 1469598103934665603ULL;
+    for (long long x : shape(t)) h = (h ^ (unsigned long long)x) * 1099511628211ULL;
+    return h;
+}
+
+static std::vector<long long> rotations(const std::vector<BSTree::Rotation>& rs) {
+    std::vector<long long> out;
+    for (const BSTree::Rotation& r : rs) out.insert(out.end(), {r.left, r.pivot, r.child});
+    return out;
+}
+
+static void sameShapes(BSTree::Balance balance, unsigned seed) {
+    std::mt19937 rng(seed);
+    BSTree b(balance);
+    PersistentTree p(balance);
+    std::vector<std::vector<long long>> versions{shape(p)};
+    for (int i = 0; i < 6000; ++i) {
+        int v = rng() % 1000;
+        bool insert = rng() % 3 != 0;
+        bool changedB = insert ? b.insert(v) : b.remove(v);
+        bool changedP = insert ? p.insert(v) : p.remove(v);
+        CHECK(changedB == changedP);
+        CHECK(rotations(b.lastRotations()) == rotations(p.lastRotations()));
+        if (changedP) versions.push_back(shape(p));
+        if (shape(b) != shape(p)) {
+            std::fprintf(stderr, "balance %d: shapes differ after op %d\n", (int)balance, i);
+            ++failures;
+            return;
+        }
+    }
+
+    // Every version is still intact
+    CHECK(p.versionCount() == (int)versions.size());
+    for (int k = 0; k < p.versionCount(); k += 37) {
+        p.checkout(k);
+        CHECK(shape(p) == versions[k]);
+    }
+    p.checkout(p.versionCount() - 1);
+
+    std::vector<int> keys;
+    for (int i = 0; i < 5000; ++i) keys.push_back(rng() % 100000);
+    CHECK(b.build(keys) == p.build(keys));
+    CHECK(shape(b) == shape(p));
+
+    // rebalance() matches inserting the preorder into a fresh tree
+    BSTree::Balance other = (BSTree::Balance)(((int)balance + 1) % 3);
+    BSTree rebuilt(other);
+    for (int v : b.preorder()) rebuilt.insert(v);
+    p.rebalance(other);
+    CHECK(shape(rebuilt) == shape(p));
+
+    CHECK(p.undo());
+    CHECK(shape(p) == shape(b));
+    CHECK(p.redo());
+    CHECK(shape(p) == shape(rebuilt));
+}
+
+static void history() {
+    PersistentTree p(BSTree::Balance::AVL);
+    for (int v : {5, 3, 8, 1, 4}) p.insert(v);
+    CHECK(p.versionCount() == 6);
+
+    // An edit after undo drops the redo branch
+    p.undo();
+    p.undo();
+    CHECK(p.canRedo());
+    p.insert(9);
+    CHECK(!p.canRedo());
+    CHECK(p.versionCount() == 5);
+    CHECK(p.inorder() == std::vector<int>({3, 5, 8, 9}));
+
+    // A no-op reports no rotations, not those of the edit before it
+    p.insert(10);
+    CHECK(!p.lastRotations().empty());
+    CHECK(!p.insert(10));
+    CHECK(p.lastRotations().empty());
+    p.insert(11);
+    CHECK(!p.remove(42));
+    CHECK(p.lastRotations().empty());
+}
+
+// Versions kept after collections look exactly as they did when they were made. Fingerprints are
+// indexed by version number since reset(), which is what survives the renumbering.
+static void checkKept(PersistentTree& p, const std::vector<unsigned long long>& fingerprints) {
+    int current = p.version();
+    for (int k = 0; k < p.versionCount(); ++k) {
+        p.checkout(k);
+        if (fingerprint(p) != fingerprints[p.droppedVersions() + k]) {
+            std::fprintf(stderr, "version %d changed after a collection\n", p.droppedVersions() + k);
+            ++failures;
+            break;
+        }
+    }
+    p.checkout(current);
+}
+
+static void collection() {
+    // Abandoned redo branches: undo a few edits, then edit again, over and over
+    std::mt19937 rng(4);
+    PersistentTree p(BSTree::Balance::RedBlack);
+    std::vector<unsigned long long> fingerprints{fingerprint(p)};
+    for (int i = 0; i < 100000; ++i) {
+        if (rng() % 4 == 0 && p.canUndo()) { p.undo(); continue; }
+        int v = rng() % 500;
+        if (rng() % 3 != 0 ? p.insert(v) : p.remove(v)) {
+            fingerprints.resize(p.droppedVersions() + p.version());
+            fingerprints.push_back(fingerprint(p));
+        }
+    }
+    CHECK(p.droppedVersions() > 0);
+    CHECK(p.slotCount() < 3 * PersistentTree::MIN_COLLECT_SLOTS);
+    checkKept(p, fingerprints);
+
+    // Each rebalance copies the whole tree; only the newest few copies may stay
+    PersistentTree q;
+    std::vector<int> keys;
+    for (int i = 0; i < 50000; ++i) keys.push_back(i * 7 % 50021);
+    q.build(keys);
+    fingerprints.assign(2, 0);
+    fingerprints[1] = fingerprint(q);
+    for (int i = 1; i <= 40; ++i) {
+        q.rebalance((BSTree::Balance)(i % 3));
+        fingerprints.push_back(fingerprint(q));
+    }
+    CHECK(q.droppedVersions() > 0);
+    CHECK(q.canUndo());
+    CHECK(q.slotCount() < (2 * PersistentTree::HISTORY_TREES + 1) * q.size() + 2 * PersistentTree::MIN_COLLECT_SLOTS);
+    std::sort(keys.begin(), keys.end());
+    CHECK(q.inorder() == keys);
+    checkKept(q, fingerprints);
+}
+
+int main() {
+    sameShapes(BSTree::Balance::None, 1);
+    sameShapes(BSTree::Balance::AVL, 2);
+    sameShapes(BSTree::Balance::RedBlack, 3);
+    history();
+    collection();
+    if (failures == 0) std::printf("persistent_tree_test: all checks passed\n");
+    return failures == 0 ? 0 : 1;
+}
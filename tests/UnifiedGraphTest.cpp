@@ -0,0 +1,56 @@
+// Edge-index consistency of UnifiedGraph under vertex removal.
+//
+//   unified_graph_test      exits non-zero on the first failed check
+
+#include <cstdio>
+#include "../src/ds/UnifiedGraph.h"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            ++failures;                                                      \
+        }                                                                    \
+    } while (0)
+
+// A removed vertex must not keep index entries for its self-loops
+static void directedSelfLoopRemoval() {
+    UnifiedGraph g(UnifiedGraph::DirectedUnweighted);
+    g.setEdgeIndex(true, UnifiedGraph::MultiEdgePolicy::Keep);
+    for (int i = 0; i < 3; ++i) g.addVertex();
+    g.addEdge(0, 0);
+    g.addEdge(0, 0);
+    g.addEdge(0, 1);
+    g.addEdge(2, 0);
+    g.addEdge(1, 2);
+    CHECK(g.edgeMultiplicity(0, 0) == 2);
+
+    CHECK(g.removeVertex(0));
+    CHECK(!g.hasEdge(0, 0));
+    CHECK(g.edgeMultiplicity(0, 0) == 0);
+    CHECK(!g.hasEdge(0, 1));
+    CHECK(!g.hasEdge(2, 0));
+    CHECK(g.hasEdge(1, 2));
+}
+
+static void undirectedSelfLoopRemoval() {
+    UnifiedGraph g(UnifiedGraph::UndirectedUnweighted);
+    g.setEdgeIndex(true, UnifiedGraph::MultiEdgePolicy::Keep);
+    for (int i = 0; i < 2; ++i) g.addVertex();
+    g.addEdge(0, 0);
+    g.addEdge(0, 1);
+    CHECK(g.edgeMultiplicity(0, 0) == 1);
+
+    CHECK(g.removeVertex(0));
+    CHECK(!g.hasEdge(0, 0));
+    CHECK(!g.hasEdge(1, 0));
+}
+
+int main() {
+    directedSelfLoopRemoval();
+    undirectedSelfLoopRemoval();
+    if (failures == 0) std::printf("unified_graph_test: all checks passed\n");
+    return failures == 0 ? 0 : 1;
+}